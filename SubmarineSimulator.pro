@@ -22,32 +22,39 @@ mac {
     ICON = icons/logo.icns
 }
 
+include(core.pri)
+include(meshes.pri)
+
 SOURCES += main.cpp\
         mainwindow.cpp \
-    simulation.cpp \
-    submarine.cpp \
-    fluid.cpp \
+    arrowrenderer.cpp \
+    assetcache.cpp \
+    chartscheduler.cpp \
     forcearrow.cpp \
+    meshdata.cpp \
+    replayplayer.cpp \
+    simulation.cpp \
+    submarineview.cpp \
+    torquearrow.cpp \
+    simulationworker.cpp \
     simulationpropertiesdialogue.cpp \
-    qcustomplot.cpp \
-    fin.cpp \
-    physics/force.cpp \
-    physics/torque.cpp \
-    physics/body.cpp \
-    torquearrow.cpp
+    qcustomplot.cpp
 
 HEADERS  += mainwindow.h \
-    simulation.h \
-    submarine.h \
-    fluid.h \
+    arrowrenderer.h \
+    assetcache.h \
+    chartscheduler.h \
     forcearrow.h \
+    meshdata.h \
+    meshformat.h \
+    replayplayer.h \
+    simulation.h \
+    submarineview.h \
+    torquearrow.h \
+    simulationworker.h \
+    triplebuffer.h \
     simulationpropertiesdialogue.h \
-    qcustomplot.h \
-    fin.h \
-    physics/force.h \
-    physics/torque.h \
-    physics/body.h \
-    torquearrow.h
+    qcustomplot.h
 
 FORMS    += mainwindow.ui \
     simulationpropertiesdialogue.ui
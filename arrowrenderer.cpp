@@ -0,0 +1,201 @@
+#include <Qt3DRenderer/QAttribute>
+#include <Qt3DRenderer/QBuffer>
+#include <Qt3DRenderer/QEffect>
+#include <Qt3DRenderer/QGeometry>
+#include <Qt3DRenderer/QGeometryRenderer>
+#include <Qt3DRenderer/QMaterial>
+#include <Qt3DRenderer/QOpenGLFilter>
+#include <Qt3DRenderer/QRenderPass>
+#include <Qt3DRenderer/QShaderProgram>
+#include <Qt3DRenderer/QTechnique>
+
+#include <QUrl>
+
+#include <algorithm>
+
+#include "assetcache.h"
+
+#include "arrowrenderer.h"
+
+namespace {
+
+// per instance: position, direction, length and colour
+const int InstanceFloats = 10;
+const int InstanceSize = InstanceFloats * sizeof(float);
+
+Qt3D::QMaterial *makeMaterial(Qt3D::QNode *parent)
+{
+    auto shader = new Qt3D::QShaderProgram();
+    shader->setVertexShaderCode(Qt3D::QShaderProgram::loadSource(QUrl("qrc:/shaders/arrow.vert")));
+    shader->setFragmentShaderCode(Qt3D::QShaderProgram::loadSource(QUrl("qrc:/shaders/arrow.frag")));
+
+    auto pass = new Qt3D::QRenderPass();
+    pass->setShaderProgram(shader);
+
+    // instanced attributes (glVertexAttribDivisor) are core from OpenGL 3.3
+    auto technique = new Qt3D::QTechnique();
+    technique->openGLFilter()->setApi(Qt3D::QOpenGLFilter::Desktop);
+    technique->openGLFilter()->setProfile(Qt3D::QOpenGLFilter::Core);
+    technique->openGLFilter()->setMajorVersion(3);
+    technique->openGLFilter()->setMinorVersion(3);
+    technique->addPass(pass);
+
+    auto effect = new Qt3D::QEffect();
+    effect->addTechnique(technique);
+
+    auto material = new Qt3D::QMaterial(parent);
+    material->setEffect(effect);
+
+    return material;
+}
+
+Qt3D::QAttribute *makeAttribute(Qt3D::QBuffer *buffer, const QString &name, uint size, int offset, uint divisor,
+                                int stride)
+{
+    auto attribute = new Qt3D::QAttribute(buffer, Qt3D::QAttribute::Float, size, 0, offset, stride);
+    attribute->setName(name);
+    attribute->setDivisor(divisor);
+
+    return attribute;
+}
+
+}
+
+ArrowRenderer::ArrowRenderer(AssetCache *assets, Qt3D::QNode *parent) :
+    Qt3D::QEntity(parent)
+{
+    Qt3D::QMaterial *material = makeMaterial(this);
+
+    makeBatch(&m_batches[Straight], assets, ":/models/arrow.obj", material);
+    makeBatch(&m_batches[Curved], assets, ":/models/torque-arrow.obj", material);
+}
+
+ArrowRenderer::~ArrowRenderer()
+{
+
+}
+
+void ArrowRenderer::makeBatch(Batch *batch, AssetCache *assets, const QString &meshFileName,
+                              Qt3D::QMaterial *material)
+{
+    batch->changed = false;
+
+    // the arrow's own vertices and indices are the cached mesh's, shared
+    // with any plain use of it
+    MeshData mesh = AssetCache::meshData(meshFileName);
+    Qt3D::QBuffer *vertexBuffer = assets->vertexBuffer(meshFileName);
+    Qt3D::QBuffer *indexBuffer = assets->indexBuffer(meshFileName);
+
+    auto entity = new Qt3D::QEntity(this);
+
+    auto geometry = new Qt3D::QGeometry(entity);
+
+    Qt3D::QAttribute *positions = makeAttribute(vertexBuffer, Qt3D::QAttribute::defaultPositionAttributeName(),
+                                                3, 0, 0, MeshData::VertexSize);
+    Qt3D::QAttribute *normals = makeAttribute(vertexBuffer, Qt3D::QAttribute::defaultNormalAttributeName(),
+                                              3, 3 * sizeof(float), 0, MeshData::VertexSize);
+    positions->setCount(mesh.vertexCount);
+    normals->setCount(mesh.vertexCount);
+
+    auto indices = new Qt3D::QAttribute(indexBuffer, Qt3D::QAttribute::UnsignedInt, 1, mesh.indexCount);
+    indices->setAttributeType(Qt3D::QAttribute::IndexAttribute);
+
+    geometry->addAttribute(positions);
+    geometry->addAttribute(normals);
+    geometry->addAttribute(indices);
+
+    batch->instanceBuffer = new Qt3D::QBuffer(Qt3D::QBuffer::VertexBuffer, geometry);
+    batch->instanceBuffer->setUsage(Qt3D::QBuffer::DynamicDraw);
+
+    batch->instanceAttributes
+            << makeAttribute(batch->instanceBuffer, "instancePosition", 3, 0, 1, InstanceSize)
+            << makeAttribute(batch->instanceBuffer, "instanceDirection", 3, 3 * sizeof(float), 1, InstanceSize)
+            << makeAttribute(batch->instanceBuffer, "instanceLength", 1, 6 * sizeof(float), 1, InstanceSize)
+            << makeAttribute(batch->instanceBuffer, "instanceColour", 3, 7 * sizeof(float), 1, InstanceSize);
+
+    for (Qt3D::QAttribute *attribute : batch->instanceAttributes) {
+        geometry->addAttribute(attribute);
+    }
+
+    batch->renderer = new Qt3D::QGeometryRenderer(entity);
+    batch->renderer->setPrimitiveType(Qt3D::QGeometryRenderer::Triangles);
+    batch->renderer->setPrimitiveCount(mesh.indexCount);
+    batch->renderer->setInstanceCount(0);
+    batch->renderer->setGeometry(geometry);
+
+    entity->addComponent(batch->renderer);
+    entity->addComponent(material);
+}
+
+int ArrowRenderer::addArrow(Shape shape, const QColor &colour)
+{
+    Batch &batch = m_batches[shape];
+
+    int index;
+    if (!batch.freeIndices.isEmpty()) {
+        index = batch.freeIndices.takeLast();
+    } else {
+        index = batch.instances.size() / InstanceFloats;
+        batch.instances.resize(batch.instances.size() + InstanceFloats);
+    }
+
+    // an arrow starts out with no length, so it isn't seen until it is set
+    float *instance = batch.instances.data() + index * InstanceFloats;
+    std::fill(instance, instance + InstanceFloats, 0.f);
+    instance[4] = 1;
+    instance[7] = colour.redF();
+    instance[8] = colour.greenF();
+    instance[9] = colour.blueF();
+
+    batch.changed = true;
+
+    return index;
+}
+
+void ArrowRenderer::removeArrow(Shape shape, int index)
+{
+    Batch &batch = m_batches[shape];
+
+    // the slot is hidden and reused by the next arrow added
+    batch.instances[index * InstanceFloats + 6] = 0;
+    batch.freeIndices.append(index);
+    batch.changed = true;
+}
+
+void ArrowRenderer::setArrow(Shape shape, int index, const QVector3D &position, const QVector3D &direction,
+                             float length)
+{
+    Batch &batch = m_batches[shape];
+    float *instance = batch.instances.data() + index * InstanceFloats;
+
+    instance[0] = position.x();
+    instance[1] = position.y();
+    instance[2] = position.z();
+    instance[3] = direction.x();
+    instance[4] = direction.y();
+    instance[5] = direction.z();
+    instance[6] = length;
+
+    batch.changed = true;
+}
+
+void ArrowRenderer::commit()
+{
+    for (Batch &batch : m_batches) {
+        if (!batch.changed) {
+            continue;
+        }
+
+        int count = batch.instances.size() / InstanceFloats;
+
+        batch.instanceBuffer->setData(QByteArray(reinterpret_cast<const char *>(batch.instances.constData()),
+                                                 batch.instances.size() * sizeof(float)));
+
+        for (Qt3D::QAttribute *attribute : batch.instanceAttributes) {
+            attribute->setCount(count);
+        }
+
+        batch.renderer->setInstanceCount(count);
+        batch.changed = false;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ARROWRENDERER_H
+#define ARROWRENDERER_H
+
+#include <QColor>
+#include <QVector3D>
+#include <QVector>
+
+#include <Qt3DCore/QEntity>
+
+namespace Qt3D {
+class QAttribute;
+class QBuffer;
+class QGeometryRenderer;
+class QMaterial;
+class QNode;
+}
+
+class AssetCache;
+
+// Draws every arrow in the scene with one instanced draw call per arrow
+// shape. Each arrow is a slot in a per-instance buffer of position,
+// direction, length and colour; changes are collected and uploaded once a
+// frame by commit().
+class ArrowRenderer : public Qt3D::QEntity
+{
+    Q_OBJECT
+
+public:
+    enum Shape
+    {
+        Straight,
+        Curved
+    };
+
+    explicit ArrowRenderer(AssetCache *assets, Qt3D::QNode *parent = 0);
+    ~ArrowRenderer();
+
+    int addArrow(Shape shape, const QColor &colour);
+    void removeArrow(Shape shape, int index);
+
+    void setArrow(Shape shape, int index, const QVector3D &position, const QVector3D &direction, float length);
+
+    void commit();
+
+private:
+    struct Batch
+    {
+        QVector<float> instances;
+        QVector<int> freeIndices;
+        bool changed;
+
+        Qt3D::QBuffer *instanceBuffer;
+        QVector<Qt3D::QAttribute *> instanceAttributes;
+        Qt3D::QGeometryRenderer *renderer;
+    };
+
+    void makeBatch(Batch *batch, AssetCache *assets, const QString &meshFileName, Qt3D::QMaterial *material);
+
+    Batch m_batches[2];
+};
+
+#endif // ARROWRENDERER_H
@@ -0,0 +1,136 @@
+#include <Qt3DRenderer/QAttribute>
+#include <Qt3DRenderer/QBuffer>
+#include <Qt3DRenderer/QGeometry>
+#include <Qt3DRenderer/QGeometryRenderer>
+#include <Qt3DRenderer/QPhongMaterial>
+#include <Qt3DRenderer/QSphereMesh>
+
+#include <QFile>
+#include <QMutex>
+#include <QtDebug>
+
+#include "assetcache.h"
+
+AssetCache::AssetCache(Qt3D::QNode *parent) :
+    Qt3D::QEntity(parent),
+    m_sphere(0)
+{
+
+}
+
+MeshData AssetCache::meshData(const QString &fileName)
+{
+    static QMutex mutex;
+    static QHash<QString, MeshData> meshes;
+
+    QMutexLocker locker(&mutex);
+
+    auto it = meshes.find(fileName);
+    if (it != meshes.end()) {
+        return *it;
+    }
+
+    // the mesh compiled from an OBJ file at build time is used in its place
+    // when there is one; a file that can't be read is only reported once,
+    // and is drawn empty
+    QString compiledFileName = fileName.left(fileName.lastIndexOf('.')) + ".mesh";
+
+    MeshData mesh;
+    QString error;
+    if (QFile::exists(compiledFileName)) {
+        if (!mapMesh(compiledFileName, &mesh, &error)) {
+            qCritical() << "Could not map" << compiledFileName << ":" << error;
+        }
+    } else if (!readObj(fileName, &mesh, &error)) {
+        qCritical() << "Could not read" << fileName << ":" << error;
+    }
+
+    meshes.insert(fileName, mesh);
+
+    return mesh;
+}
+
+Qt3D::QBuffer *AssetCache::vertexBuffer(const QString &fileName)
+{
+    Qt3D::QBuffer *&buffer = m_vertexBuffers[fileName];
+
+    if (!buffer) {
+        buffer = new Qt3D::QBuffer(Qt3D::QBuffer::VertexBuffer, this);
+        buffer->setUsage(Qt3D::QBuffer::StaticDraw);
+        buffer->setData(meshData(fileName).vertices);
+    }
+
+    return buffer;
+}
+
+Qt3D::QBuffer *AssetCache::indexBuffer(const QString &fileName)
+{
+    Qt3D::QBuffer *&buffer = m_indexBuffers[fileName];
+
+    if (!buffer) {
+        buffer = new Qt3D::QBuffer(Qt3D::QBuffer::IndexBuffer, this);
+        buffer->setUsage(Qt3D::QBuffer::StaticDraw);
+        buffer->setData(meshData(fileName).indices);
+    }
+
+    return buffer;
+}
+
+Qt3D::QGeometryRenderer *AssetCache::mesh(const QString &fileName)
+{
+    Qt3D::QGeometryRenderer *&mesh = m_meshes[fileName];
+
+    if (!mesh) {
+        Qt3D::QBuffer *buffer = vertexBuffer(fileName);
+        MeshData data = meshData(fileName);
+        int vertexCount = data.vertexCount;
+
+        auto positions = new Qt3D::QAttribute(buffer, Qt3D::QAttribute::Float, 3, vertexCount,
+                                              0, MeshData::VertexSize);
+        positions->setName(Qt3D::QAttribute::defaultPositionAttributeName());
+
+        auto normals = new Qt3D::QAttribute(buffer, Qt3D::QAttribute::Float, 3, vertexCount,
+                                            3 * sizeof(float), MeshData::VertexSize);
+        normals->setName(Qt3D::QAttribute::defaultNormalAttributeName());
+
+        auto indices = new Qt3D::QAttribute(indexBuffer(fileName), Qt3D::QAttribute::UnsignedInt, 1,
+                                            data.indexCount);
+        indices->setAttributeType(Qt3D::QAttribute::IndexAttribute);
+
+        auto geometry = new Qt3D::QGeometry(this);
+        geometry->addAttribute(positions);
+        geometry->addAttribute(normals);
+        geometry->addAttribute(indices);
+
+        mesh = new Qt3D::QGeometryRenderer(this);
+        mesh->setPrimitiveType(Qt3D::QGeometryRenderer::Triangles);
+        mesh->setPrimitiveCount(data.indexCount);
+        mesh->setGeometry(geometry);
+    }
+
+    return mesh;
+}
+
+Qt3D::QSphereMesh *AssetCache::sphere()
+{
+    if (!m_sphere) {
+        m_sphere = new Qt3D::QSphereMesh(this);
+        m_sphere->setRadius(0.5);
+        m_sphere->setRings(24);
+        m_sphere->setSlices(48);
+    }
+
+    return m_sphere;
+}
+
+Qt3D::QPhongMaterial *AssetCache::material(const QColor &ambient)
+{
+    Qt3D::QPhongMaterial *&material = m_materials[ambient.rgba()];
+
+    if (!material) {
+        material = new Qt3D::QPhongMaterial(this);
+        material->setAmbient(ambient);
+    }
+
+    return material;
+}
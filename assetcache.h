@@ -0,0 +1,49 @@
+#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include <QColor>
+#include <QHash>
+
+#include <Qt3DCore/QEntity>
+
+#include "meshdata.h"
+
+namespace Qt3D {
+class QBuffer;
+class QGeometryRenderer;
+class QNode;
+class QPhongMaterial;
+class QSphereMesh;
+}
+
+// The meshes and materials of a scene, each made once and used as a
+// component by every entity that shows it, so that its buffers are only
+// uploaded once. The mesh files themselves are read once per process,
+// from the compiled .mesh next to an .obj when there is one.
+class AssetCache : public Qt3D::QEntity
+{
+    Q_OBJECT
+
+public:
+    explicit AssetCache(Qt3D::QNode *parent = 0);
+
+    static MeshData meshData(const QString &fileName);
+
+    Qt3D::QBuffer *vertexBuffer(const QString &fileName);
+    Qt3D::QBuffer *indexBuffer(const QString &fileName);
+    Qt3D::QGeometryRenderer *mesh(const QString &fileName);
+
+    // a sphere of unit diameter, for hulls
+    Qt3D::QSphereMesh *sphere();
+
+    Qt3D::QPhongMaterial *material(const QColor &ambient);
+
+private:
+    QHash<QString, Qt3D::QBuffer *> m_vertexBuffers;
+    QHash<QString, Qt3D::QBuffer *> m_indexBuffers;
+    QHash<QString, Qt3D::QGeometryRenderer *> m_meshes;
+    Qt3D::QSphereMesh *m_sphere;
+    QHash<QRgb, Qt3D::QPhongMaterial *> m_materials;
+};
+
+#endif // ASSETCACHE_H
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <random>
+
+#include <QStringList>
+#include <QTextStream>
+#include <QtConcurrent>
+#include <QtDebug>
+#include <QtMath>
+
+#include "propertypath.h"
+#include "simulationcore.h"
+
+#include "ensemble.h"
+
+namespace {
+
+struct RunMember
+{
+    typedef RunSummary result_type;
+
+    RunMember(const Ensemble *ensemble, double duration) :
+        ensemble(ensemble),
+        duration(duration)
+    {
+
+    }
+
+    RunSummary operator()(int run) const
+    {
+        SimulationCore core;
+
+        QString error;
+        if (!ensemble->applyRun(&core, run, &error)) {
+            qCritical() << "Run" << run << "failed:" << error;
+            return RunSummary();
+        }
+
+        return RunSummary::run(&core, duration);
+    }
+
+    const Ensemble *ensemble;
+    double duration;
+};
+
+double percentile(QVector<double> values, double p)
+{
+    if (values.isEmpty()) {
+        return 0;
+    }
+
+    int index = qBound(0, qRound(p * (values.size() - 1)), values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+
+    return values[index];
+}
+
+double mean(const QVector<double> &values)
+{
+    if (values.isEmpty()) {
+        return 0;
+    }
+
+    double sum = 0;
+    for (double value : values) {
+        sum += value;
+    }
+
+    return sum / values.size();
+}
+
+void writeStatistics(QTextStream &log, const QString &name, const QVector<double> &values)
+{
+    log << name
+        << ": mean " << qRadiansToDegrees(mean(values))
+        << ", p5 " << qRadiansToDegrees(percentile(values, 0.05))
+        << ", p50 " << qRadiansToDegrees(percentile(values, 0.5))
+        << ", p95 " << qRadiansToDegrees(percentile(values, 0.95))
+        << ", max " << qRadiansToDegrees(percentile(values, 1)) << " deg" << endl;
+}
+
+}
+
+Ensemble::Ensemble(quint64 seed) :
+    m_seed(seed)
+{
+
+}
+
+bool Ensemble::parseParameter(const QString &specification, Parameter *parameter, QString *error)
+{
+    // path=normal:mean:stddev or path=uniform:min:max
+    int equals = specification.indexOf('=');
+    if (equals <= 0) {
+        *error = QString("Expected path=distribution in \"%1\"").arg(specification);
+        return false;
+    }
+
+    parameter->path = specification.left(equals);
+
+    QStringList fields = specification.mid(equals + 1).split(':');
+    if (fields.size() != 3) {
+        *error = QString("Expected distribution:a:b in \"%1\"").arg(specification);
+        return false;
+    }
+
+    if (fields[0] == "normal") {
+        parameter->distribution = Normal;
+    } else if (fields[0] == "uniform") {
+        parameter->distribution = Uniform;
+    } else {
+        *error = QString("Unknown distribution \"%1\"").arg(fields[0]);
+        return false;
+    }
+
+    bool aOk, bOk;
+    parameter->a = fields[1].toDouble(&aOk);
+    parameter->b = fields[2].toDouble(&bOk);
+
+    if (!aOk || !bOk || !qIsFinite(parameter->a) || !qIsFinite(parameter->b)) {
+        *error = QString("Invalid distribution parameters in \"%1\"").arg(specification);
+        return false;
+    }
+
+    // the standard distributions are undefined otherwise
+    if (parameter->distribution == Normal && parameter->b <= 0) {
+        *error = QString("Expected a positive standard deviation in \"%1\"").arg(specification);
+        return false;
+    }
+
+    if (parameter->distribution == Uniform && parameter->a >= parameter->b) {
+        *error = QString("Expected min below max in \"%1\"").arg(specification);
+        return false;
+    }
+
+    return true;
+}
+
+void Ensemble::addParameter(const Parameter &parameter)
+{
+    m_parameters.append(parameter);
+}
+
+void Ensemble::setScenario(const Scenario &scenario)
+{
+    m_scenario = scenario;
+}
+
+quint64 Ensemble::seed() const
+{
+    return m_seed;
+}
+
+QVector<double> Ensemble::runValues(int run) const
+{
+    // each run has its own generator, seeded only from the ensemble seed and
+    // the run index, so any run can be reproduced on its own
+    std::seed_seq seedSequence = { quint32(m_seed), quint32(m_seed >> 32), quint32(run) };
+    std::mt19937_64 generator(seedSequence);
+
+    QVector<double> values(m_parameters.size());
+
+    for (int i = 0; i < m_parameters.size(); i++) {
+        const Parameter &parameter = m_parameters[i];
+
+        switch (parameter.distribution) {
+        case Normal:
+            values[i] = std::normal_distribution<double>(parameter.a, parameter.b)(generator);
+            break;
+
+        case Uniform:
+            values[i] = std::uniform_real_distribution<double>(parameter.a, parameter.b)(generator);
+            break;
+        }
+    }
+
+    return values;
+}
+
+bool Ensemble::applyRun(SimulationCore *core, int run, QString *error) const
+{
+    if (!m_scenario.apply(core, error)) {
+        return false;
+    }
+
+    QVector<double> values = runValues(run);
+
+    for (int i = 0; i < m_parameters.size(); i++) {
+        if (!writePropertyPath(core, m_parameters[i].path, values[i])) {
+            *error = QString("Unknown parameter \"%1\"").arg(m_parameters[i].path);
+            return false;
+        }
+    }
+
+    core->reset();
+
+    return true;
+}
+
+void Ensemble::run(int runs, double duration, QTextStream &output, QTextStream &log) const
+{
+    QVector<int> members(runs);
+    for (int i = 0; i < runs; i++) {
+        members[i] = i;
+    }
+
+    QStringList header;
+    header << "run";
+    for (const Parameter &parameter : m_parameters) {
+        header << parameter.path;
+    }
+    header << RunSummary::columnNames();
+
+    output.setRealNumberPrecision(17);
+    output << header.join(',') << '\n';
+
+    QVector<double> maxRolls, maxYaws, maxPitches;
+    maxRolls.reserve(runs);
+    maxYaws.reserve(runs);
+    maxPitches.reserve(runs);
+
+    QFuture<RunSummary> future = QtConcurrent::mapped(members, RunMember(this, duration));
+
+    int progressInterval = qMax(1, runs / 10);
+
+    // results are streamed out in run order as soon as each one is ready
+    for (int i = 0; i < runs; i++) {
+        RunSummary summary = future.resultAt(i);
+
+        output << i;
+
+        for (double value : runValues(i)) {
+            output << ',' << value;
+        }
+
+        for (double value : summary.columns()) {
+            output << ',' << value;
+        }
+
+        output << '\n';
+
+        maxRolls.append(summary.maxRoll);
+        maxYaws.append(summary.maxYaw);
+        maxPitches.append(summary.maxPitch);
+
+        if ((i + 1) % progressInterval == 0 || i + 1 == runs) {
+            output.flush();
+
+            log << i + 1 << "/" << runs << " runs" << endl;
+            writeStatistics(log, "  roll excursion", maxRolls);
+            writeStatistics(log, "  yaw excursion", maxYaws);
+            writeStatistics(log, "  pitch excursion", maxPitches);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <QString>
+#include <QVector>
+
+#include "runsummary.h"
+#include "scenario.h"
+
+class QTextStream;
+class SimulationCore;
+
+class Ensemble
+{
+public:
+    enum Distribution {
+        Normal,
+        Uniform
+    };
+
+    struct Parameter
+    {
+        QString path;
+        Distribution distribution;
+        double a;  // mean or minimum
+        double b;  // standard deviation or maximum
+    };
+
+    explicit Ensemble(quint64 seed = 0);
+
+    static bool parseParameter(const QString &specification, Parameter *parameter, QString *error);
+
+    void addParameter(const Parameter &parameter);
+    void setScenario(const Scenario &scenario);
+
+    quint64 seed() const;
+
+    QVector<double> runValues(int run) const;
+
+    bool applyRun(SimulationCore *core, int run, QString *error) const;
+
+    void run(int runs, double duration, QTextStream &output, QTextStream &log) const;
+
+private:
+    quint64 m_seed;
+    QVector<Parameter> m_parameters;
+    Scenario m_scenario;
+};
+
+#endif // ENSEMBLE_H
@@ -0,0 +1,336 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include "ensemble.h"
+#include "parametersweep.h"
+#include "scenario.h"
+#include "simulationcore.h"
+#include "telemetryrecorder.h"
+#include "trajectorywriter.h"
+
+int runSingle(const QCommandLineParser &parser, const Scenario &scenario, const QString &output, double duration, int every)
+{
+    QTextStream err(stderr);
+
+    TrajectoryWriter writer(output);
+    if (!writer.open()) {
+        err << "Could not open " << writer.fileName() << ": " << writer.errorString() << endl;
+        return 1;
+    }
+
+    SimulationCore core;
+
+    QString error;
+    if (!scenario.apply(&core, &error)) {
+        err << error << endl;
+        return 1;
+    }
+
+    core.reset();
+
+    if (parser.isSet("save-scenario")) {
+        QString fileName = parser.value("save-scenario");
+        Scenario::Format format = fileName.endsWith(".json") ? Scenario::Json : Scenario::Binary;
+
+        Scenario captured = Scenario::capture(&core, duration);
+        if (!captured.save(fileName, format)) {
+            err << "Could not save " << fileName << ": " << captured.errorString() << endl;
+            return 1;
+        }
+    }
+
+    if (parser.isSet("restore-state")) {
+        QFile file(parser.value("restore-state"));
+        if (!file.open(QIODevice::ReadOnly)) {
+            err << "Could not open " << file.fileName() << ": " << file.errorString() << endl;
+            return 1;
+        }
+
+        if (!core.restoreState(file.readAll())) {
+            err << file.fileName() << " is not a saved simulation state" << endl;
+            return 1;
+        }
+    }
+
+    TelemetryRecorder recorder;
+    if (parser.isSet("record")) {
+        if (!recorder.open(parser.value("record"), &core)) {
+            err << "Could not open " << recorder.fileName() << ": " << recorder.errorString() << endl;
+            return 1;
+        }
+
+        recorder.record(&core);
+        core.setRecorder(&recorder);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    writer.write(&core);
+
+    // a restored run carries on from where it was saved
+    double end = core.time() + duration;
+
+    while (core.time() < end) {
+        core.step();
+
+        if (core.frame() % every == 0) {
+            writer.write(&core);
+        }
+    }
+
+    writer.close();
+    recorder.close();
+
+    if (parser.isSet("save-state")) {
+        QFile file(parser.value("save-state"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(core.saveState()) < 0) {
+            err << "Could not save to " << file.fileName() << ": " << file.errorString() << endl;
+            return 1;
+        }
+    }
+
+    err << "Simulated " << core.time() << " s (" << core.frame() << " frames) in "
+        << timer.elapsed() / 1000. << " s" << endl;
+
+    return 0;
+}
+
+int runSweep(const QCommandLineParser &parser, const Scenario &scenario, const QString &output, double duration)
+{
+    QTextStream err(stderr);
+
+    ParameterSweep sweep;
+    sweep.setScenario(scenario);
+
+    for (const QString &specification : parser.values("sweep")) {
+        ParameterSweep::Parameter parameter;
+        QString error;
+
+        if (!ParameterSweep::parseParameter(specification, &parameter, &error)) {
+            err << error << endl;
+            return 1;
+        }
+
+        sweep.addParameter(parameter);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<RunSummary> results = sweep.run(duration);
+
+    QString error;
+    if (!sweep.write(output, results, &error)) {
+        err << "Could not write " << output << ": " << error << endl;
+        return 1;
+    }
+
+    err << "Ran " << sweep.caseCount() << " cases of " << duration << " s on "
+        << QThreadPool::globalInstance()->maxThreadCount() << " threads in "
+        << timer.elapsed() / 1000. << " s" << endl;
+
+    return 0;
+}
+
+int runEnsemble(const QCommandLineParser &parser, const Scenario &scenario, const QString &output, double duration)
+{
+    QTextStream err(stderr);
+
+    bool ok;
+    int runs = parser.value("ensemble").toInt(&ok);
+    if (!ok || runs < 1) {
+        err << "Invalid run count: " << parser.value("ensemble") << endl;
+        return 1;
+    }
+
+    quint64 seed = parser.value("seed").toULongLong(&ok);
+    if (!ok) {
+        err << "Invalid seed: " << parser.value("seed") << endl;
+        return 1;
+    }
+
+    Ensemble ensemble(seed);
+    ensemble.setScenario(scenario);
+
+    for (const QString &specification : parser.values("perturb")) {
+        Ensemble::Parameter parameter;
+        QString error;
+
+        if (!Ensemble::parseParameter(specification, &parameter, &error)) {
+            err << error << endl;
+            return 1;
+        }
+
+        ensemble.addParameter(parameter);
+    }
+
+    QFile file(output);
+
+    bool opened;
+    if (output == "-") {
+        opened = file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        opened = file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+    }
+
+    if (!opened) {
+        err << "Could not open " << output << ": " << file.errorString() << endl;
+        return 1;
+    }
+
+    QTextStream stream(&file);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    err << "Running " << runs << " runs with seed " << seed << endl;
+
+    ensemble.run(runs, duration, stream, err);
+
+    err << "Ran " << runs << " runs of " << duration << " s in "
+        << timer.elapsed() / 1000. << " s" << endl;
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    a.setApplicationName("submarine-batch");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs the submarine simulation without a window, as fast as possible.");
+    parser.addHelpOption();
+
+    QCommandLineOption durationOption(QStringList() << "d" << "duration",
+                                      "Simulated time to run for, in seconds. Defaults to the scenario's "
+                                      "duration, or 60.", "seconds", "60");
+    parser.addOption(durationOption);
+
+    QCommandLineOption scenarioOption(QStringList() << "s" << "scenario",
+                                      "Start from a JSON or binary scenario file; --set is applied on top.",
+                                      "file");
+    parser.addOption(scenarioOption);
+
+    QCommandLineOption saveScenarioOption("save-scenario",
+                                          "Write the complete scenario of a single run, after --scenario and "
+                                          "--set, as JSON if the file ends in .json and binary otherwise.",
+                                          "file");
+    parser.addOption(saveScenarioOption);
+
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+                                    "File to write to, or - for standard output.", "file");
+    parser.addOption(outputOption);
+
+    QCommandLineOption everyOption(QStringList() << "e" << "every",
+                                   "Only write every nth frame.", "frames", "1");
+    parser.addOption(everyOption);
+
+    QCommandLineOption recordOption("record",
+                                    "Also record every frame, with all forces and torques, "
+                                    "to a binary telemetry file.", "file");
+    parser.addOption(recordOption);
+
+    QCommandLineOption restoreStateOption("restore-state",
+                                          "Start from a state saved with --save-state or the simulator. "
+                                          "The saved parameters replace any --set.", "file");
+    parser.addOption(restoreStateOption);
+
+    QCommandLineOption saveStateOption("save-state",
+                                       "Save the complete state at the end of the run, to continue from later.",
+                                       "file");
+    parser.addOption(saveStateOption);
+
+    QCommandLineOption setOption("set",
+                                 "Set a parameter, e.g. submarine.mass=150.", "path=value");
+    parser.addOption(setOption);
+
+    QCommandLineOption sweepOption("sweep",
+                                   "Sweep a parameter over start:stop:count or a,b,c. "
+                                   "Repeat to sweep the full grid of several parameters.", "path=values");
+    parser.addOption(sweepOption);
+
+    QCommandLineOption ensembleOption("ensemble",
+                                      "Run a Monte Carlo ensemble of this many runs.", "runs");
+    parser.addOption(ensembleOption);
+
+    QCommandLineOption perturbOption("perturb",
+                                     "Draw a parameter from normal:mean:stddev or uniform:min:max "
+                                     "for every ensemble run.", "path=distribution");
+    parser.addOption(perturbOption);
+
+    QCommandLineOption seedOption("seed",
+                                  "Seed for the ensemble; run i always draws the same values for a given seed.",
+                                  "seed", "0");
+    parser.addOption(seedOption);
+
+    QCommandLineOption threadsOption(QStringList() << "j" << "threads",
+                                     "Number of cases to run in parallel.", "count",
+                                     QString::number(QThread::idealThreadCount()));
+    parser.addOption(threadsOption);
+
+    parser.process(a);
+
+    QTextStream err(stderr);
+
+    Scenario scenario;
+    if (parser.isSet(scenarioOption) && !scenario.load(parser.value(scenarioOption))) {
+        err << "Could not load " << parser.value(scenarioOption) << ": " << scenario.errorString() << endl;
+        return 1;
+    }
+
+    // values are passed as strings and converted to each property's own type
+    for (const QString &assignment : parser.values(setOption)) {
+        int equals = assignment.indexOf('=');
+        if (equals <= 0) {
+            err << "Invalid parameter: " << assignment << endl;
+            return 1;
+        }
+
+        scenario.setValue(assignment.left(equals), assignment.mid(equals + 1));
+    }
+
+    bool ok;
+    double duration = parser.value(durationOption).toDouble(&ok);
+    if (!ok || duration < 0) {
+        err << "Invalid duration: " << parser.value(durationOption) << endl;
+        return 1;
+    }
+
+    if (!parser.isSet(durationOption) && scenario.duration() > 0) {
+        duration = scenario.duration();
+    }
+
+    int every = parser.value(everyOption).toInt(&ok);
+    if (!ok || every < 1) {
+        err << "Invalid frame interval: " << parser.value(everyOption) << endl;
+        return 1;
+    }
+
+    int threads = parser.value(threadsOption).toInt(&ok);
+    if (!ok || threads < 1) {
+        err << "Invalid thread count: " << parser.value(threadsOption) << endl;
+        return 1;
+    }
+
+    QThreadPool::globalInstance()->setMaxThreadCount(threads);
+
+    if (parser.isSet(ensembleOption)) {
+        QString output = parser.isSet(outputOption) ? parser.value(outputOption) : "ensemble.csv";
+        return runEnsemble(parser, scenario, output, duration);
+    }
+
+    if (parser.isSet(sweepOption)) {
+        QString output = parser.isSet(outputOption) ? parser.value(outputOption) : "sweep.csv";
+        return runSweep(parser, scenario, output, duration);
+    }
+
+    QString output = parser.isSet(outputOption) ? parser.value(outputOption) : "trajectory.csv";
+    return runSingle(parser, scenario, output, duration, every);
+}
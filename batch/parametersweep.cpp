@@ -0,0 +1,207 @@
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <QtConcurrent>
+#include <QtDebug>
+
+#include "propertypath.h"
+#include "simulationcore.h"
+
+#include "parametersweep.h"
+
+namespace {
+
+struct RunCase
+{
+    typedef RunSummary result_type;
+
+    RunCase(const ParameterSweep *sweep, double duration) :
+        sweep(sweep),
+        duration(duration)
+    {
+
+    }
+
+    RunSummary operator()(int index) const
+    {
+        SimulationCore core;
+
+        QString error;
+        if (!sweep->applyCase(&core, index, &error)) {
+            qCritical() << "Case" << index << "failed:" << error;
+            return RunSummary();
+        }
+
+        return RunSummary::run(&core, duration);
+    }
+
+    const ParameterSweep *sweep;
+    double duration;
+};
+
+}
+
+ParameterSweep::ParameterSweep()
+{
+
+}
+
+bool ParameterSweep::parseParameter(const QString &specification, Parameter *parameter, QString *error)
+{
+    // path=start:stop:count or path=a,b,c
+    int equals = specification.indexOf('=');
+    if (equals <= 0) {
+        *error = QString("Expected path=values in \"%1\"").arg(specification);
+        return false;
+    }
+
+    parameter->path = specification.left(equals);
+    parameter->values.clear();
+
+    QString values = specification.mid(equals + 1);
+
+    if (values.contains(':')) {
+        QStringList range = values.split(':');
+        if (range.size() != 3) {
+            *error = QString("Expected start:stop:count in \"%1\"").arg(specification);
+            return false;
+        }
+
+        bool startOk, stopOk, countOk;
+        double start = range[0].toDouble(&startOk);
+        double stop = range[1].toDouble(&stopOk);
+        int count = range[2].toInt(&countOk);
+
+        if (!startOk || !stopOk || !countOk || count < 1) {
+            *error = QString("Invalid range in \"%1\"").arg(specification);
+            return false;
+        }
+
+        for (int i = 0; i < count; i++) {
+            double t = count == 1 ? 0 : double(i) / (count - 1);
+            parameter->values.append(start + (stop - start) * t);
+        }
+    } else {
+        for (const QString &value : values.split(',')) {
+            bool ok;
+            parameter->values.append(value.toDouble(&ok));
+
+            if (!ok) {
+                *error = QString("Invalid value \"%1\" in \"%2\"").arg(value, specification);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void ParameterSweep::addParameter(const Parameter &parameter)
+{
+    m_parameters.append(parameter);
+}
+
+void ParameterSweep::setScenario(const Scenario &scenario)
+{
+    m_scenario = scenario;
+}
+
+int ParameterSweep::caseCount() const
+{
+    int count = 1;
+    for (const Parameter &parameter : m_parameters) {
+        count *= parameter.values.size();
+    }
+
+    return count;
+}
+
+QVector<double> ParameterSweep::caseValues(int index) const
+{
+    // the last parameter varies fastest
+    QVector<double> values(m_parameters.size());
+
+    for (int i = m_parameters.size() - 1; i >= 0; i--) {
+        const QVector<double> &parameterValues = m_parameters[i].values;
+        values[i] = parameterValues[index % parameterValues.size()];
+        index /= parameterValues.size();
+    }
+
+    return values;
+}
+
+bool ParameterSweep::applyCase(SimulationCore *core, int index, QString *error) const
+{
+    if (!m_scenario.apply(core, error)) {
+        return false;
+    }
+
+    QVector<double> values = caseValues(index);
+
+    for (int i = 0; i < m_parameters.size(); i++) {
+        if (!writePropertyPath(core, m_parameters[i].path, values[i])) {
+            *error = QString("Unknown parameter \"%1\"").arg(m_parameters[i].path);
+            return false;
+        }
+    }
+
+    // rebuild the body so that shape, mass and fins pick up the new values
+    core->reset();
+
+    return true;
+}
+
+QVector<RunSummary> ParameterSweep::run(double duration) const
+{
+    QVector<int> cases(caseCount());
+    for (int i = 0; i < cases.size(); i++) {
+        cases[i] = i;
+    }
+
+    return QtConcurrent::blockingMapped<QVector<RunSummary> >(cases, RunCase(this, duration));
+}
+
+bool ParameterSweep::write(const QString &fileName, const QVector<RunSummary> &results, QString *error) const
+{
+    QFile file(fileName);
+
+    bool opened;
+    if (fileName == "-") {
+        opened = file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        opened = file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+    }
+
+    if (!opened) {
+        *error = file.errorString();
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream.setRealNumberPrecision(9);
+
+    QStringList header;
+    header << "case";
+    for (const Parameter &parameter : m_parameters) {
+        header << parameter.path;
+    }
+    header << RunSummary::columnNames();
+
+    stream << header.join(',') << '\n';
+
+    for (int i = 0; i < results.size(); i++) {
+        stream << i;
+
+        for (double value : caseValues(i)) {
+            stream << ',' << value;
+        }
+
+        for (double value : results[i].columns()) {
+            stream << ',' << value;
+        }
+
+        stream << '\n';
+    }
+
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include <QString>
+#include <QVector>
+
+#include "runsummary.h"
+#include "scenario.h"
+
+class SimulationCore;
+
+class ParameterSweep
+{
+public:
+    struct Parameter
+    {
+        QString path;
+        QVector<double> values;
+    };
+
+    ParameterSweep();
+
+    static bool parseParameter(const QString &specification, Parameter *parameter, QString *error);
+
+    void addParameter(const Parameter &parameter);
+    void setScenario(const Scenario &scenario);
+
+    int caseCount() const;
+    QVector<double> caseValues(int index) const;
+
+    bool applyCase(SimulationCore *core, int index, QString *error) const;
+
+    QVector<RunSummary> run(double duration) const;
+
+    bool write(const QString &fileName, const QVector<RunSummary> &results, QString *error) const;
+
+private:
+    QVector<Parameter> m_parameters;
+    Scenario m_scenario;
+};
+
+#endif // PARAMETERSWEEP_H
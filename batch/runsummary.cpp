@@ -0,0 +1,58 @@
+#include <QtMath>
+
+#include "physics/body.h"
+#include "simulationcore.h"
+#include "submarine.h"
+
+#include "runsummary.h"
+
+RunSummary::RunSummary() :
+    time(0),
+    maxRoll(0),
+    maxYaw(0),
+    maxPitch(0)
+{
+
+}
+
+RunSummary RunSummary::run(SimulationCore *core, double duration)
+{
+    RunSummary summary;
+    summary.record(core);
+
+    while (core->time() < duration) {
+        core->step();
+        summary.record(core);
+    }
+
+    return summary;
+}
+
+void RunSummary::record(const SimulationCore *core)
+{
+    const Physics::Body *body = core->submarine()->body();
+
+    time = core->time();
+    position = body->position();
+    linearVelocity = body->linearVelocity();
+
+    maxRoll = qMax(maxRoll, qAbs(body->roll()));
+    maxYaw = qMax(maxYaw, qAbs(body->yaw()));
+    maxPitch = qMax(maxPitch, qAbs(body->pitch()));
+}
+
+QStringList RunSummary::columnNames()
+{
+    return QStringList() << "time"
+                         << "x" << "y" << "z"
+                         << "vx" << "vy" << "vz"
+                         << "maxRoll" << "maxYaw" << "maxPitch";
+}
+
+QVector<double> RunSummary::columns() const
+{
+    return QVector<double>() << time
+                             << position.x() << position.y() << position.z()
+                             << linearVelocity.x() << linearVelocity.y() << linearVelocity.z()
+                             << maxRoll << maxYaw << maxPitch;
+}
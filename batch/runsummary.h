@@ -0,0 +1,30 @@
+#ifndef RUNSUMMARY_H
+#define RUNSUMMARY_H
+
+#include <QStringList>
+#include <QVector3D>
+#include <QVector>
+
+class SimulationCore;
+
+class RunSummary
+{
+public:
+    RunSummary();
+
+    static RunSummary run(SimulationCore *core, double duration);
+
+    void record(const SimulationCore *core);
+
+    static QStringList columnNames();
+    QVector<double> columns() const;
+
+    double time;
+    QVector3D position;
+    QVector3D linearVelocity;
+    double maxRoll;
+    double maxYaw;
+    double maxPitch;
+};
+
+#endif // RUNSUMMARY_H
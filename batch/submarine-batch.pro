@@ -0,0 +1,35 @@
+#-------------------------------------------------
+#
+# Headless batch runner, sharing the physics with SubmarineSimulator
+#
+#-------------------------------------------------
+
+# gui only for QVector3D and QQuaternion; nothing here renders
+QT += core gui concurrent
+
+QT_CONFIG -= no-pkg-config
+CONFIG += link_pkgconfig
+PKGCONFIG += bullet
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = submarine-batch
+TEMPLATE = app
+
+include(../core.pri)
+
+SOURCES += main.cpp \
+    ensemble.cpp \
+    parametersweep.cpp \
+    runsummary.cpp \
+    trajectorywriter.cpp
+
+HEADERS += ensemble.h \
+    parametersweep.h \
+    runsummary.h \
+    trajectorywriter.h
+
+mac {
+    PKG_CONFIG = /usr/local/bin/pkg-config
+}
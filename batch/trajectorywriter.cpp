@@ -0,0 +1,80 @@
+#include <QVector3D>
+
+#include "physics/body.h"
+#include "simulationcore.h"
+#include "submarine.h"
+
+#include "trajectorywriter.h"
+
+TrajectoryWriter::TrajectoryWriter(const QString &fileName) :
+    m_file(fileName)
+{
+
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}
+
+bool TrajectoryWriter::open()
+{
+    bool opened;
+    if (m_file.fileName() == "-") {
+        opened = m_file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        opened = m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+    }
+
+    if (!opened) {
+        return false;
+    }
+
+    m_stream.setDevice(&m_file);
+    m_stream.setRealNumberPrecision(9);
+
+    m_stream << "time,"
+             << "x,y,z,"
+             << "vx,vy,vz,"
+             << "wx,wy,wz,"
+             << "roll,yaw,pitch,"
+             << "rollAngleOfAttack,yawAngleOfAttack,pitchAngleOfAttack\n";
+
+    return true;
+}
+
+void TrajectoryWriter::close()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    m_stream.flush();
+    m_file.close();
+}
+
+void TrajectoryWriter::write(const SimulationCore *core)
+{
+    const Physics::Body *body = core->submarine()->body();
+
+    QVector3D position = body->position();
+    QVector3D linearVelocity = body->linearVelocity();
+    QVector3D angularVelocity = body->angularVelocity();
+
+    m_stream << core->time() << ','
+             << position.x() << ',' << position.y() << ',' << position.z() << ','
+             << linearVelocity.x() << ',' << linearVelocity.y() << ',' << linearVelocity.z() << ','
+             << angularVelocity.x() << ',' << angularVelocity.y() << ',' << angularVelocity.z() << ','
+             << body->roll() << ',' << body->yaw() << ',' << body->pitch() << ','
+             << body->rollAngleOfAttack() << ',' << body->yawAngleOfAttack() << ',' << body->pitchAngleOfAttack() << '\n';
+}
+
+QString TrajectoryWriter::fileName() const
+{
+    return m_file.fileName();
+}
+
+QString TrajectoryWriter::errorString() const
+{
+    return m_file.errorString();
+}
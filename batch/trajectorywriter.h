@@ -0,0 +1,28 @@
+#ifndef TRAJECTORYWRITER_H
+#define TRAJECTORYWRITER_H
+
+#include <QFile>
+#include <QTextStream>
+
+class SimulationCore;
+
+class TrajectoryWriter
+{
+public:
+    explicit TrajectoryWriter(const QString &fileName);
+    ~TrajectoryWriter();
+
+    bool open();
+    void close();
+
+    void write(const SimulationCore *core);
+
+    QString fileName() const;
+    QString errorString() const;
+
+private:
+    QFile m_file;
+    QTextStream m_stream;
+};
+
+#endif // TRAJECTORYWRITER_H
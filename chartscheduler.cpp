@@ -0,0 +1,75 @@
+#include <QTimer>
+
+#include "qcustomplot.h"
+
+#include "chartscheduler.h"
+
+ChartScheduler::ChartScheduler(QObject *parent) :
+    QObject(parent),
+    m_refreshRate(0),
+    m_timer(new QTimer(this))
+{
+    connect(m_timer, &QTimer::timeout, this, &ChartScheduler::refresh);
+    setRefreshRate(15);
+}
+
+void ChartScheduler::addPlot(QCustomPlot *plot, Qt::Orientations rescaledAxes)
+{
+    Plot p;
+    p.plot = plot;
+    p.rescaledAxes = rescaledAxes;
+    p.dirty = true;
+
+    m_plots.append(p);
+}
+
+void ChartScheduler::markDirty()
+{
+    for (Plot &p : m_plots) {
+        p.dirty = true;
+    }
+}
+
+void ChartScheduler::refresh()
+{
+    for (Plot &p : m_plots) {
+        // hidden plots stay dirty, and catch up once they are shown again
+        if (!p.dirty || !isShown(p.plot)) {
+            continue;
+        }
+
+        // however many samples arrived since the last refresh, each axis is
+        // only rescaled once
+        if (p.rescaledAxes & Qt::Horizontal) {
+            p.plot->xAxis->rescale();
+        }
+
+        if (p.rescaledAxes & Qt::Vertical) {
+            p.plot->yAxis->rescale();
+        }
+
+        p.plot->replot();
+        p.dirty = false;
+    }
+}
+
+bool ChartScheduler::isShown(const QCustomPlot *plot) const
+{
+    return plot->isVisible() && !plot->window()->isMinimized() && !plot->visibleRegion().isEmpty();
+}
+
+double ChartScheduler::refreshRate() const
+{
+    return m_refreshRate;
+}
+
+void ChartScheduler::setRefreshRate(double refreshRate)
+{
+    m_refreshRate = refreshRate;
+
+    if (m_refreshRate > 0) {
+        m_timer->start(qMax(1, int(1000 / m_refreshRate)));
+    } else {
+        m_timer->stop();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef CHARTSCHEDULER_H
+#define CHARTSCHEDULER_H
+
+#include <QObject>
+#include <QVector>
+
+class QCustomPlot;
+class QTimer;
+
+class ChartScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ChartScheduler(QObject *parent = 0);
+
+    void addPlot(QCustomPlot *plot, Qt::Orientations rescaledAxes);
+
+    void markDirty();
+
+public slots:
+    void refresh();
+
+public:
+    double refreshRate() const;
+    void setRefreshRate(double refreshRate);
+
+    Q_PROPERTY(double refreshRate READ refreshRate WRITE setRefreshRate)
+
+private:
+    struct Plot
+    {
+        QCustomPlot *plot;
+        Qt::Orientations rescaledAxes;
+        bool dirty;
+    };
+
+    bool isShown(const QCustomPlot *plot) const;
+
+    QVector<Plot> m_plots;
+
+    double m_refreshRate;
+    QTimer *m_timer;
+};
+
+#endif // CHARTSCHEDULER_H
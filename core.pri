@@ -0,0 +1,40 @@
+INCLUDEPATH += $$PWD
+
+QT += concurrent
+
+SOURCES += \
+    $$PWD/simulationcore.cpp \
+    $$PWD/propertypath.cpp \
+    $$PWD/scenario.cpp \
+    $$PWD/telemetryfile.cpp \
+    $$PWD/telemetryrecorder.cpp \
+    $$PWD/submarine.cpp \
+    $$PWD/fluid.cpp \
+    $$PWD/gridfluidfield.cpp \
+    $$PWD/streamingfluidfield.cpp \
+    $$PWD/fin.cpp \
+    $$PWD/physics/force.cpp \
+    $$PWD/physics/forcepipeline.cpp \
+    $$PWD/physics/torque.cpp \
+    $$PWD/physics/body.cpp
+
+HEADERS += \
+    $$PWD/simulationcore.h \
+    $$PWD/simulationsnapshot.h \
+    $$PWD/propertypath.h \
+    $$PWD/samplequeue.h \
+    $$PWD/scenario.h \
+    $$PWD/telemetryfile.h \
+    $$PWD/telemetryformat.h \
+    $$PWD/telemetryrecorder.h \
+    $$PWD/submarine.h \
+    $$PWD/fluid.h \
+    $$PWD/fluidfield.h \
+    $$PWD/fluidfieldformat.h \
+    $$PWD/gridfluidfield.h \
+    $$PWD/streamingfluidfield.h \
+    $$PWD/fin.h \
+    $$PWD/physics/force.h \
+    $$PWD/physics/forcepipeline.h \
+    $$PWD/physics/torque.h \
+    $$PWD/physics/body.h
@@ -1,20 +1,13 @@
-#include <Qt3DCore/QEntity>
-#include <Qt3DCore/QRotateTransform>
-#include <Qt3DCore/QTransform>
-#include <Qt3DCore/QTranslateTransform>
-#include <Qt3DRenderer/QMesh>
+#include <QtDebug>
 #include <QtMath>
 #include <QVector2D>
 
 #include <bullet/btBulletDynamicsCommon.h>
 
-#include "fluid.h"
-#include "forcearrow.h"
 #include "physics/body.h"
 #include "physics/force.h"
 #include "physics/torque.h"
 #include "submarine.h"
-#include "torquearrow.h"
 
 #include "fin.h"
 
@@ -23,47 +16,53 @@ float calculateEllipseProportion(float proportion)
     return qSqrt(1.f - (proportion * proportion));
 }
 
-Fin::Fin(Qt3D::QEntity *scene, Qt3D::QNode *parent) :
-    Qt3D::QEntity(parent),
+Fin::Fin(Orientation orientation, QObject *parent) :
+    QObject(parent),
+    m_submarine(0),
+    m_orientation(orientation),
     m_plane(Unknown),
+    m_area(0),
+    m_aspectRatio(0),
     m_forcePosition(new btVector3()),
     m_drag(new Physics::DragForce(this)),
     m_lift(new Physics::LiftForce(this)),
     m_damping(new Physics::FinDampingTorque(this))
 {
-    auto mesh = new Qt3D::QMesh(this);
-    mesh->setSource(QUrl("qrc:/models/fin.obj"));
-    addComponent(mesh);
-
-    m_rotateTransform = new Qt3D::QRotateTransform(this);
-    m_rotateTransform->setAxis(QVector3D(1, 0, 0));
+    switch (orientation) {
+    case North:
+        setObjectName("northFin");
+        break;
 
-    m_translateTransform = new Qt3D::QTranslateTransform(this);
+    case East:
+        setObjectName("eastFin");
+        break;
 
-    auto transform = new Qt3D::QTransform(this);
-    transform->addTransform(m_translateTransform);
-    transform->addTransform(m_rotateTransform);
-    addComponent(transform);
+    case South:
+        setObjectName("southFin");
+        break;
 
-    auto liftArrow = new ForceArrow(QColor(0xc0392b), 200., scene);
-    liftArrow->setForce(m_lift);
+    case West:
+        setObjectName("westFin");
+        break;
+    }
 
-    auto dragArrow = new ForceArrow(QColor(0x27ae60), 150., scene);
-    dragArrow->setForce(m_drag);
+    m_drag->setObjectName("drag");
+    m_lift->setObjectName("lift");
+    m_damping->setObjectName("damping");
+}
 
-    auto dampingArrow = new TorqueArrow(QColor(0xf1c40f), 1000., scene);
-    dampingArrow->setTorque(m_damping);
+Fin::~Fin()
+{
+    delete m_forcePosition;
 }
 
 void Fin::calculatePosition(Orientation orientation, float position)
 {
-    m_translateTransform->setDx(position);
+    m_orientation = orientation;
 
     float p = qAbs(position) / (submarine()->length() / 2.);
     float radius = calculateEllipseProportion(p) * (submarine()->width() / 2.f);
 
-    m_translateTransform->setDy(radius);
-
     m_forcePosition->setX(position);
 
     switch (orientation) {
@@ -89,26 +88,6 @@ void Fin::calculatePosition(Orientation orientation, float position)
     // FIXME this is required :/
     qDebug() << "p:" << position;
 
-    // TODO rotate fin
-
-    switch (orientation) {
-    case North:
-        m_rotateTransform->setAngleDeg(0);
-        break;
-
-    case East:
-        m_rotateTransform->setAngleDeg(90);
-        break;
-
-    case South:
-        m_rotateTransform->setAngleDeg(180);
-        break;
-
-    case West:
-        m_rotateTransform->setAngleDeg(270);
-        break;
-    }
-
     switch (orientation) {
     case North:
     case South:
@@ -132,39 +111,34 @@ void Fin::calculatePosition(Orientation orientation, float position)
     m_lift->setPosition(QVector3D(m_forcePosition->x(), m_forcePosition->y(), m_forcePosition->z()));
 
     m_damping->setBody(submarine()->body());
+    m_damping->setPosition(QVector3D(m_forcePosition->x(), m_forcePosition->y(), m_forcePosition->z()));
 }
 
-void Fin::applyForces(const Fluid *fluid) const
+Fin::Orientation Fin::orientation() const
 {
-    applyLift(fluid);
-    applyDrag(fluid);
-    applyDamping(fluid);
+    return m_orientation;
 }
 
-void Fin::applyLift(const Fluid *fluid) const
+Fin::Plane Fin::plane() const
 {
-    m_lift->setFluidDensity(fluid->density());
-
-    m_lift->apply();
+    return m_plane;
 }
 
-void Fin::applyDrag(const Fluid *fluid) const
+double Fin::angle() const
 {
-    m_drag->setFluidDensity(fluid->density());
-
-    m_drag->apply();
-}
+    switch (m_orientation) {
+    case East:
+        return 90;
 
-void Fin::applyDamping(const Fluid *fluid) const
-{
-    m_damping->setFluidDensity(fluid->density());
+    case South:
+        return 180;
 
-    m_damping->apply();
-}
+    case West:
+        return 270;
 
-Fin::Plane Fin::plane() const
-{
-    return m_plane;
+    default:
+        return 0;
+    }
 }
 
 Submarine *Fin::submarine() const
@@ -190,6 +164,18 @@ void Fin::setArea(double area)
     m_damping->setCrossSectionalArea(m_area);
 }
 
+double Fin::aspectRatio() const
+{
+    return m_aspectRatio;
+}
+
+void Fin::setAspectRatio(double aspectRatio)
+{
+    m_aspectRatio = aspectRatio;
+
+    m_damping->setAspectRatio(m_aspectRatio);
+}
+
 Physics::DragForce *Fin::drag() const
 {
     return m_drag;
@@ -1,17 +1,10 @@
 #ifndef FIN_H
 #define FIN_H
 
-#include <Qt3DCore/QEntity>
-
-namespace Qt3D {
-class QRotateTransform;
-class QTranslateTransform;
-}
+#include <QObject>
 
 class btVector3;
 
-class Fluid;
-class ForceArrow;
 class Submarine;
 
 namespace Physics {
@@ -20,7 +13,7 @@ class FinDampingTorque;
 class LiftForce;
 }
 
-class Fin : public Qt3D::QEntity
+class Fin : public QObject
 {
     Q_OBJECT
 
@@ -38,36 +31,39 @@ public:
         Vertical
     };
 
-    explicit Fin(Qt3D::QEntity *scene, Qt3D::QNode *parent = 0);
+    explicit Fin(Orientation orientation, QObject *parent = 0);
+    ~Fin();
 
     void calculatePosition(Orientation orientation, float position);
 
-    void applyForces(const Fluid *fluid) const;
-    void applyLift(const Fluid *fluid) const;
-    void applyDrag(const Fluid *fluid) const;
-    void applyDamping(const Fluid *fluid) const;
-
     Submarine *submarine() const;
     void setSubmarine(Submarine *submarine);
 
+    Orientation orientation() const;
     Plane plane() const;
 
+    // about the hull's axis, in degrees from the top
+    double angle() const;
+
     double area() const;
     void setArea(double area);
 
+    double aspectRatio() const;
+    void setAspectRatio(double aspectRatio);
+
     Physics::DragForce *drag() const;
     Physics::LiftForce *lift() const;
     Physics::FinDampingTorque *damping() const;
 
     Q_PROPERTY(Submarine *submarine READ submarine WRITE setSubmarine)
+    Q_PROPERTY(Orientation orientation READ orientation)
     Q_PROPERTY(Plane plane READ plane)
     Q_PROPERTY(double area READ area WRITE setArea)
+    Q_PROPERTY(double aspectRatio READ aspectRatio WRITE setAspectRatio)
 
 private:
-    Qt3D::QRotateTransform *m_rotateTransform;
-    Qt3D::QTranslateTransform *m_translateTransform;
-
     Submarine *m_submarine;
+    Orientation m_orientation;
     Plane m_plane;
     double m_area;
     double m_aspectRatio;
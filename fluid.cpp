@@ -1,6 +1,53 @@
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QWeakPointer>
+
+#include "gridfluidfield.h"
+#include "streamingfluidfield.h"
+
 #include "fluid.h"
 
-Fluid::Fluid(QObject *parent) : QObject(parent)
+namespace {
+
+// field files larger than this are streamed from disk rather than loaded
+const qint64 StreamingSize = Q_INT64_C(256) << 20;
+
+// runs in parallel share one copy of each field file
+QSharedPointer<const FluidField> loadField(const QString &fileName, QString *error)
+{
+    static QMutex mutex;
+    static QHash<QString, QWeakPointer<const FluidField> > fields;
+
+    QMutexLocker locker(&mutex);
+
+    QSharedPointer<const FluidField> field = fields.value(fileName).toStrongRef();
+    if (field) {
+        return field;
+    }
+
+    if (QFileInfo(fileName).size() > StreamingSize) {
+        field = QSharedPointer<const FluidField>(
+                    StreamingFluidField::open(fileName, StreamingFluidField::DefaultResidentTiles, error));
+    } else {
+        field = QSharedPointer<const FluidField>(GridFluidField::load(fileName, error));
+    }
+
+    if (!field) {
+        return field;
+    }
+
+    fields.insert(fileName, field);
+
+    return field;
+}
+
+}
+
+Fluid::Fluid(QObject *parent) :
+    QObject(parent),
+    m_density(0),
+    m_temperature(0)
 {
 
 }
@@ -9,10 +56,48 @@ Fluid *Fluid::makeDefault(QObject *parent) {
     Fluid *fluid = new Fluid(parent);
 
     fluid->setDensity(1000);  // water
+    fluid->setTemperature(10);
 
     return fluid;
 }
 
+FluidSample Fluid::sample(const QVector3D &position, double time) const
+{
+    if (m_field) {
+        return m_field->sample(position, time);
+    }
+
+    FluidSample sample;
+    sample.density = m_density;
+    sample.temperature = m_temperature;
+    sample.current = m_current;
+
+    return sample;
+}
+
+void Fluid::prefetch(const void *source, const QVector3D &position, const QVector3D &velocity,
+                     double time) const
+{
+    if (m_field) {
+        m_field->prefetch(source, position, velocity, time);
+    }
+}
+
+bool Fluid::isUniform() const
+{
+    return !m_field;
+}
+
+QSharedPointer<const FluidField> Fluid::field() const
+{
+    return m_field;
+}
+
+void Fluid::setField(QSharedPointer<const FluidField> field)
+{
+    m_field = field;
+}
+
 double Fluid::density() const
 {
     return m_density;
@@ -22,3 +107,55 @@ void Fluid::setDensity(double density)
 {
     m_density = density;
 }
+
+double Fluid::temperature() const
+{
+    return m_temperature;
+}
+
+void Fluid::setTemperature(double temperature)
+{
+    m_temperature = temperature;
+}
+
+QVector3D Fluid::current() const
+{
+    return m_current;
+}
+
+void Fluid::setCurrent(const QVector3D &current)
+{
+    m_current = current;
+}
+
+QString Fluid::fieldFile() const
+{
+    return m_fieldFile;
+}
+
+void Fluid::setFieldFile(const QString &fieldFile)
+{
+    if (fieldFile == m_fieldFile) {
+        return;
+    }
+
+    QSharedPointer<const FluidField> field;
+    if (!fieldFile.isEmpty()) {
+        QString error;
+        field = loadField(fieldFile, &error);
+        if (!field) {
+            // keep the fluid as it was rather than quietly going uniform
+            m_errorString = QString("Could not load fluid field %1: %2").arg(fieldFile, error);
+            return;
+        }
+    }
+
+    m_errorString.clear();
+    m_fieldFile = fieldFile;
+    m_field = field;
+}
+
+QString Fluid::errorString() const
+{
+    return m_errorString;
+}
@@ -2,6 +2,9 @@
 #define FLUID_H
 
 #include <QObject>
+#include <QSharedPointer>
+
+#include "fluidfield.h"
 
 class Fluid : public QObject
 {
@@ -12,13 +15,42 @@ public:
 
     static Fluid *makeDefault(QObject *parent = 0);
 
+    FluidSample sample(const QVector3D &position, double time) const;
+    void prefetch(const void *source, const QVector3D &position, const QVector3D &velocity, double time) const;
+    bool isUniform() const;
+
+    QSharedPointer<const FluidField> field() const;
+    void setField(QSharedPointer<const FluidField> field);
+
     double density() const;
     void setDensity(double density);
 
+    double temperature() const;
+    void setTemperature(double temperature);
+
+    QVector3D current() const;
+    void setCurrent(const QVector3D &current);
+
+    QString fieldFile() const;
+    void setFieldFile(const QString &fieldFile);
+
+    // why the last setFieldFile() failed, which leaves fieldFile unchanged
+    QString errorString() const;
+
     Q_PROPERTY(double density READ density WRITE setDensity)
+    Q_PROPERTY(double temperature READ temperature WRITE setTemperature)
+    Q_PROPERTY(QVector3D current READ current WRITE setCurrent)
+    Q_PROPERTY(QString fieldFile READ fieldFile WRITE setFieldFile)
 
 private:
     double m_density;
+    double m_temperature;
+    QVector3D m_current;
+
+    // when set, the field replaces the uniform values above
+    QString m_fieldFile;
+    QSharedPointer<const FluidField> m_field;
+    QString m_errorString;
 };
 
 #endif // FLUID_H
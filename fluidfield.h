@@ -0,0 +1,45 @@
+#ifndef FLUIDFIELD_H
+#define FLUIDFIELD_H
+
+#include <QVector3D>
+
+struct FluidSample
+{
+    FluidSample() :
+        density(0),
+        temperature(0)
+    {
+
+    }
+
+    float density;      // kg/m^3
+    float temperature;  // degrees C
+    QVector3D current;  // m/s, world frame
+};
+
+// Fluid properties that vary with position and time. Implementations are
+// sampled from the physics thread of every run sharing them, so sample()
+// and prefetch() must be safe to call concurrently.
+class FluidField
+{
+public:
+    virtual ~FluidField()
+    {
+
+    }
+
+    virtual FluidSample sample(const QVector3D &position, double time) const = 0;
+
+    // a hint that source, at position and moving at velocity, will sample
+    // the field along its path from time on, replacing its earlier hints
+    virtual void prefetch(const void *source, const QVector3D &position, const QVector3D &velocity,
+                          double time) const
+    {
+        Q_UNUSED(source);
+        Q_UNUSED(position);
+        Q_UNUSED(velocity);
+        Q_UNUSED(time);
+    }
+};
+
+#endif // FLUIDFIELD_H
@@ -0,0 +1,139 @@
+#ifndef FLUIDFIELDFORMAT_H
+#define FLUIDFIELDFORMAT_H
+
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+#include <QVector3D>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cstring>
+
+// A fluid field file is laid out as
+//
+//   FluidFieldFormat::Header
+//   double frameTimes[frameCount]
+//   Node nodes[frameCount][bricksZ][bricksY][bricksX][BrickSize^3]
+//
+// with everything little endian. The grid is split into cubic bricks of
+// BrickSize nodes a side, stored x fastest within a brick, so that the
+// nodes around any point are close together in memory. A grid whose size
+// isn't a multiple of BrickSize is padded out to one. Frames are sorted by
+// time; between frames the field is interpolated linearly.
+
+namespace FluidFieldFormat {
+
+const char Magic[8] = { 'S', 'U', 'B', 'F', 'L', 'U', 'I', 'D' };
+const quint32 Version = 1;
+const int BrickSize = 8;
+const int BrickNodes = BrickSize * BrickSize * BrickSize;
+
+struct Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 frameCount;
+    quint32 size[3];     // nodes along x, y and z
+    quint32 reserved;
+    double origin[3];    // world position of node (0, 0, 0)
+    double spacing[3];   // distance between nodes along x, y and z
+};
+
+struct Node
+{
+    float density;
+    float temperature;
+    float current[3];
+};
+
+Q_STATIC_ASSERT(sizeof(Header) == 80);
+Q_STATIC_ASSERT(sizeof(Node) == 20);
+Q_STATIC_ASSERT(Q_BYTE_ORDER == Q_LITTLE_ENDIAN);
+
+// reads and checks the header and frame times, leaving the device at the
+// first node
+inline bool readHeader(QIODevice *device, Header *header, QVector<double> *frameTimes, QString *error)
+{
+    if (device->read(reinterpret_cast<char *>(header), sizeof(*header)) != sizeof(*header) ||
+            memcmp(header->magic, Magic, sizeof(header->magic)) != 0) {
+        *error = "Not a fluid field file";
+        return false;
+    }
+
+    if (header->version != Version) {
+        *error = QString("Unsupported fluid field version %1").arg(header->version);
+        return false;
+    }
+
+    if (header->frameCount == 0 || header->spacing[0] <= 0 || header->spacing[1] <= 0 || header->spacing[2] <= 0) {
+        *error = "Invalid fluid field grid";
+        return false;
+    }
+
+    frameTimes->resize(header->frameCount);
+    qint64 timesSize = frameTimes->size() * sizeof(double);
+    if (device->read(reinterpret_cast<char *>(frameTimes->data()), timesSize) != timesSize) {
+        *error = "Truncated fluid field file";
+        return false;
+    }
+
+    return true;
+}
+
+// the grid cell around a position, clamped to the grid: the lower and upper
+// node along each axis and how far between them the position lies
+struct Cell
+{
+    int lower[3];
+    int upper[3];
+    float weights[3];
+};
+
+inline Cell locateCell(const QVector3D &position, const QVector3D &origin, const QVector3D &spacing,
+                       const int *size)
+{
+    Cell cell;
+
+    for (int axis = 0; axis < 3; axis++) {
+        float g = (position[axis] - origin[axis]) / spacing[axis];
+        g = qBound(0.f, g, float(size[axis] - 1));
+
+        cell.lower[axis] = qMin(int(g), size[axis] - 1);
+        cell.upper[axis] = qMin(cell.lower[axis] + 1, size[axis] - 1);
+        cell.weights[axis] = g - cell.lower[axis];
+    }
+
+    return cell;
+}
+
+// the frame at or before a time, clamped to the frames, and the weight of
+// the frame after it
+inline int locateFrame(const double *times, int count, double time, float *weight)
+{
+    int frame = std::upper_bound(times, times + count, time) - times - 1;
+
+    if (frame < 0 || frame >= count - 1) {
+        *weight = 0;
+        return qBound(0, frame, count - 1);
+    }
+
+    *weight = (time - times[frame]) / (times[frame + 1] - times[frame]);
+    return frame;
+}
+
+// the offset of a node within its brick, and the index of the brick within
+// its frame
+inline int nodeOffset(int x, int y, int z)
+{
+    return ((z % BrickSize) * BrickSize + y % BrickSize) * BrickSize + x % BrickSize;
+}
+
+inline int brickIndex(int x, int y, int z, const int *bricks)
+{
+    return ((z / BrickSize) * bricks[1] + y / BrickSize) * bricks[0] + x / BrickSize;
+}
+
+}
+
+#endif // FLUIDFIELDFORMAT_H
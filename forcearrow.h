@@ -2,54 +2,35 @@
 #define FORCEARROW_H
 
 #include <QColor>
-#include <Qt3DCore/QEntity>
+#include <QObject>
+#include <QPointer>
 #include <QVector3D>
 
-namespace Qt3D {
-class QEntity;
-class QNode;
-class QRotateTransform;
-class QTranslateTransform;
-class QScaleTransform;
-}
+class ArrowRenderer;
 
-class btVector3;
-
-namespace Physics {
-class Force;
-}
-
-class ForceArrow : public Qt3D::QEntity
+class ForceArrow : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit ForceArrow(QColor colour, float scale, Qt3D::QNode *parent = 0);
+    explicit ForceArrow(ArrowRenderer *renderer, QColor colour, float scale, QObject *parent = 0);
     ~ForceArrow();
 
-private slots:
-    void update();
+    void update(const QVector3D &force, const QVector3D &position);
 
-public:
     QColor colour() const;
 
     float scale() const;
 
-    Physics::Force *force() const;
-    void setForce(Physics::Force *force);
-
     Q_PROPERTY(QColor colour READ colour)
     Q_PROPERTY(float scale READ scale)
-    Q_PROPERTY(Physics::Force *force READ force WRITE setForce)
 
 private:
     QColor m_colour;
     float m_scale;
-    Physics::Force *m_force;
 
-    Qt3D::QRotateTransform *m_rotateTransform;
-    Qt3D::QTranslateTransform *m_translateTransform;
-    Qt3D::QScaleTransform *m_scaleTransform;
+    QPointer<ArrowRenderer> m_renderer;
+    int m_index;
 };
 
 #endif // FORCEARROW_H
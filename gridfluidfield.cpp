@@ -0,0 +1,185 @@
+#include <QFile>
+#include <QString>
+
+#include <cstring>
+
+#include "gridfluidfield.h"
+
+using FluidFieldFormat::BrickSize;
+using FluidFieldFormat::BrickNodes;
+using FluidFieldFormat::Node;
+
+GridFluidField::GridFluidField(const QVector3D &origin, const QVector3D &spacing,
+                               int sizeX, int sizeY, int sizeZ, const QVector<double> &frameTimes) :
+    m_origin(origin),
+    m_spacing(spacing),
+    m_frameTimes(frameTimes)
+{
+    m_size[0] = qMax(1, sizeX);
+    m_size[1] = qMax(1, sizeY);
+    m_size[2] = qMax(1, sizeZ);
+
+    for (int axis = 0; axis < 3; axis++) {
+        m_bricks[axis] = (m_size[axis] + BrickSize - 1) / BrickSize;
+    }
+
+    if (m_frameTimes.isEmpty()) {
+        m_frameTimes.append(0);
+    }
+
+    m_frameNodes = m_bricks[0] * m_bricks[1] * m_bricks[2] * BrickNodes;
+    m_nodes.resize(m_frameTimes.size() * m_frameNodes);
+}
+
+GridFluidField *GridFluidField::load(const QString &fileName, QString *error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return 0;
+    }
+
+    FluidFieldFormat::Header header;
+    QVector<double> frameTimes;
+    if (!FluidFieldFormat::readHeader(&file, &header, &frameTimes, error)) {
+        return 0;
+    }
+
+    GridFluidField *field = new GridFluidField(QVector3D(header.origin[0], header.origin[1], header.origin[2]),
+                                               QVector3D(header.spacing[0], header.spacing[1], header.spacing[2]),
+                                               header.size[0], header.size[1], header.size[2], frameTimes);
+
+    // the file holds the bricks exactly as they are laid out in memory
+    qint64 nodesSize = field->m_nodes.size() * sizeof(Node);
+    if (file.read(reinterpret_cast<char *>(field->m_nodes.data()), nodesSize) != nodesSize) {
+        *error = "Truncated fluid field file";
+        delete field;
+        return 0;
+    }
+
+    return field;
+}
+
+bool GridFluidField::save(const QString &fileName, QString *error) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = file.errorString();
+        return false;
+    }
+
+    FluidFieldFormat::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FluidFieldFormat::Magic, sizeof(header.magic));
+    header.version = FluidFieldFormat::Version;
+    header.frameCount = m_frameTimes.size();
+
+    for (int axis = 0; axis < 3; axis++) {
+        header.size[axis] = m_size[axis];
+        header.origin[axis] = m_origin[axis];
+        header.spacing[axis] = m_spacing[axis];
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(m_frameTimes.constData()), m_frameTimes.size() * sizeof(double));
+    file.write(reinterpret_cast<const char *>(m_nodes.constData()), m_nodes.size() * sizeof(Node));
+
+    if (file.error() != QFile::NoError) {
+        *error = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+FluidSample GridFluidField::sample(const QVector3D &position, double time) const
+{
+    FluidFieldFormat::Cell cell = FluidFieldFormat::locateCell(position, m_origin, m_spacing, m_size);
+
+    float t;
+    int frame = FluidFieldFormat::locateFrame(m_frameTimes.constData(), m_frameTimes.size(), time, &t);
+
+    FluidSample sample;
+    sampleFrame(frame, cell, 1 - t, &sample);
+    if (t > 0) {
+        sampleFrame(frame + 1, cell, t, &sample);
+    }
+
+    return sample;
+}
+
+void GridFluidField::sampleFrame(int frame, const FluidFieldFormat::Cell &cell, float frameWeight,
+                                 FluidSample *sample) const
+{
+    for (int corner = 0; corner < 8; corner++) {
+        int x = corner & 1 ? cell.upper[0] : cell.lower[0];
+        int y = corner & 2 ? cell.upper[1] : cell.lower[1];
+        int z = corner & 4 ? cell.upper[2] : cell.lower[2];
+
+        float w = frameWeight;
+        w *= corner & 1 ? cell.weights[0] : 1 - cell.weights[0];
+        w *= corner & 2 ? cell.weights[1] : 1 - cell.weights[1];
+        w *= corner & 4 ? cell.weights[2] : 1 - cell.weights[2];
+
+        const Node &node = at(frame, x, y, z);
+        sample->density += w * node.density;
+        sample->temperature += w * node.temperature;
+        sample->current += w * QVector3D(node.current[0], node.current[1], node.current[2]);
+    }
+}
+
+FluidSample GridFluidField::node(int frame, int x, int y, int z) const
+{
+    const Node &node = at(frame, x, y, z);
+
+    FluidSample sample;
+    sample.density = node.density;
+    sample.temperature = node.temperature;
+    sample.current = QVector3D(node.current[0], node.current[1], node.current[2]);
+
+    return sample;
+}
+
+void GridFluidField::setNode(int frame, int x, int y, int z, const FluidSample &sample)
+{
+    Node &node = at(frame, x, y, z);
+
+    node.density = sample.density;
+    node.temperature = sample.temperature;
+    node.current[0] = sample.current.x();
+    node.current[1] = sample.current.y();
+    node.current[2] = sample.current.z();
+}
+
+QVector3D GridFluidField::origin() const
+{
+    return m_origin;
+}
+
+QVector3D GridFluidField::spacing() const
+{
+    return m_spacing;
+}
+
+int GridFluidField::size(int axis) const
+{
+    return m_size[axis];
+}
+
+QVector<double> GridFluidField::frameTimes() const
+{
+    return m_frameTimes;
+}
+
+const Node &GridFluidField::at(int frame, int x, int y, int z) const
+{
+    int brick = FluidFieldFormat::brickIndex(x, y, z, m_bricks);
+    int offset = FluidFieldFormat::nodeOffset(x, y, z);
+
+    return m_nodes[frame * m_frameNodes + brick * BrickNodes + offset];
+}
+
+Node &GridFluidField::at(int frame, int x, int y, int z)
+{
+    return const_cast<Node &>(static_cast<const GridFluidField *>(this)->at(frame, x, y, z));
+}
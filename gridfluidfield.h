@@ -0,0 +1,49 @@
+#ifndef GRIDFLUIDFIELD_H
+#define GRIDFLUIDFIELD_H
+
+#include <QVector>
+
+#include "fluidfield.h"
+#include "fluidfieldformat.h"
+
+class QString;
+
+// A fluid field sampled on a regular grid, held in memory in the bricked
+// layout of FluidFieldFormat and interpolated trilinearly in space and
+// linearly in time. Outside the grid the nearest boundary value is used.
+class GridFluidField : public FluidField
+{
+public:
+    GridFluidField(const QVector3D &origin, const QVector3D &spacing,
+                   int sizeX, int sizeY, int sizeZ, const QVector<double> &frameTimes = QVector<double>(1, 0.));
+
+    static GridFluidField *load(const QString &fileName, QString *error);
+    bool save(const QString &fileName, QString *error) const;
+
+    FluidSample sample(const QVector3D &position, double time) const;
+
+    FluidSample node(int frame, int x, int y, int z) const;
+    void setNode(int frame, int x, int y, int z, const FluidSample &sample);
+
+    QVector3D origin() const;
+    QVector3D spacing() const;
+    int size(int axis) const;
+    QVector<double> frameTimes() const;
+
+private:
+    const FluidFieldFormat::Node &at(int frame, int x, int y, int z) const;
+    FluidFieldFormat::Node &at(int frame, int x, int y, int z);
+
+    void sampleFrame(int frame, const FluidFieldFormat::Cell &cell, float frameWeight, FluidSample *sample) const;
+
+    QVector3D m_origin;
+    QVector3D m_spacing;
+    int m_size[3];
+    int m_bricks[3];
+    int m_frameNodes;
+
+    QVector<double> m_frameTimes;
+    QVector<FluidFieldFormat::Node> m_nodes;
+};
+
+#endif // GRIDFLUIDFIELD_H
@@ -1,4 +1,10 @@
+#include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QLabel>
 #include <QMessageBox>
+#include <QSlider>
+#include <QToolBar>
 #include <QWidget>
 #include <QTimer>
 
@@ -7,14 +13,29 @@
 #include <QMacToolBarItem>
 #endif
 
-#include "physics/body.h"
+#include "chartscheduler.h"
+#include "replayplayer.h"
+#include "samplequeue.h"
+#include "scenario.h"
 #include "simulationpropertiesdialogue.h"
-#include "submarine.h"
 #include "simulation.h"
+#include "simulationsnapshot.h"
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
+// the time charts keep half an hour at the default 60 steps a second, drawn
+// through their rings' envelopes in time proportional to their width; the
+// position chart isn't in key order, so every point of it is drawn
+const int TimeChartCapacity = 30 * 60 * 60;
+const int PositionChartCapacity = 2000;
+
+void setChartCapacity(QCustomPlot *plot, int capacity) {
+    for (int i = 0; i < plot->graphCount(); i++) {
+        plot->graph(i)->setDataCapacity(capacity);
+    }
+}
+
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow)
@@ -25,6 +46,7 @@ MainWindow::MainWindow(QWidget *parent) :
 
     m_simulation = new Simulation();
     m_simulation->show();
+    connect(m_simulation, &Simulation::recordingStopped, this, &MainWindow::telemetryRecordingStopped);
 
     m_simulationWidget = QWidget::createWindowContainer(m_simulation, this);
     m_simulationWidget->setMinimumSize(320, 320);
@@ -88,7 +110,23 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->chartPosition->yAxis->setLabel("Y/Z (m)");
     ui->chartPosition->legend->setVisible(true);
 
-    m_timer->start(25);
+    setChartCapacity(ui->chartAngle, TimeChartCapacity);
+    setChartCapacity(ui->chartAngularVelocity, TimeChartCapacity);
+    setChartCapacity(ui->chartAngleOfAttack, TimeChartCapacity);
+    setChartCapacity(ui->chartLinearVelocity, TimeChartCapacity);
+    setChartCapacity(ui->chartPosition, PositionChartCapacity);
+
+    m_chartScheduler = new ChartScheduler(this);
+    m_chartScheduler->addPlot(ui->chartAngle, Qt::Horizontal);
+    m_chartScheduler->addPlot(ui->chartAngularVelocity, Qt::Horizontal);
+    m_chartScheduler->addPlot(ui->chartAngleOfAttack, Qt::Horizontal);
+    m_chartScheduler->addPlot(ui->chartLinearVelocity, Qt::Horizontal);
+    m_chartScheduler->addPlot(ui->chartPosition, Qt::Horizontal | Qt::Vertical);
+
+    initialiseReplayToolbar();
+
+    connect(m_timer, &QTimer::timeout, this, &MainWindow::updateSimulation);
+    m_timer->start(16);
 
 #ifdef Q_OS_OSX
     initialiseMacToolbar();
@@ -126,29 +164,125 @@ void MainWindow::initialiseMacToolbar()
     ui->mainToolBar->hide();
 }
 
+void MainWindow::initialiseReplayToolbar()
+{
+    m_replaySlider = new QSlider(Qt::Horizontal);
+    m_replaySlider->setRange(0, 1000);
+    connect(m_replaySlider, &QSlider::valueChanged, this, &MainWindow::seekReplay);
+
+    m_replaySpeed = new QComboBox();
+    m_replaySpeed->addItem("0.25x", 0.25);
+    m_replaySpeed->addItem("0.5x", 0.5);
+    m_replaySpeed->addItem("1x", 1.0);
+    m_replaySpeed->addItem("2x", 2.0);
+    m_replaySpeed->addItem("4x", 4.0);
+    m_replaySpeed->addItem("8x", 8.0);
+    m_replaySpeed->setCurrentIndex(2);
+    connect(m_replaySpeed, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &MainWindow::changeReplaySpeed);
+
+    m_replayTime = new QLabel();
+
+    m_replayToolBar = new QToolBar("Replay", this);
+    m_replayToolBar->addWidget(m_replaySlider);
+    m_replayToolBar->addWidget(m_replayTime);
+    m_replayToolBar->addWidget(m_replaySpeed);
+    m_replayToolBar->addAction(ui->actionClose_Replay);
+    m_replayToolBar->hide();
+    addToolBar(Qt::BottomToolBarArea, m_replayToolBar);
+}
+
+void MainWindow::updateReplayToolbar()
+{
+    ReplayPlayer *replay = m_simulation->replay();
+
+    double duration = replay->endTime() - replay->startTime();
+    int position = 0;
+    if (duration > 0) {
+        position = qRound((replay->time() - replay->startTime()) / duration * m_replaySlider->maximum());
+    }
+
+    // only a user's drag should seek
+    if (!m_replaySlider->isSliderDown()) {
+        m_replaySlider->blockSignals(true);
+        m_replaySlider->setValue(position);
+        m_replaySlider->blockSignals(false);
+    }
+
+    m_replayTime->setText(QString("%1 / %2 s").arg(replay->time(), 0, 'f', 2).arg(replay->endTime(), 0, 'f', 2));
+}
+
 void MainWindow::showAbout() {
     QMessageBox::about(this, "Submarine Simulation", "A submarine simulation developed for SUHPS.\n\nIcons from Material Design by Google.");
 }
 
 void MainWindow::changeSimulationProperties() {
+    bool wasRunning = m_simulation->isRunning();
+    pauseSimulation();
+
     SimulationPropertiesDialogue d(this);
     d.loadSimulation(m_simulation);
     if (d.exec() == QDialog::Accepted) {
-        restartSimulation();
         d.saveSimulation(m_simulation);
+        restartSimulation();
 
-        if (d.shouldStartPaused()) {
-            pauseSimulation();
+        if (!d.shouldStartPaused()) {
+            playSimulation();
         }
+    } else if (wasRunning) {
+        playSimulation();
     }
 }
 
-void limitChartData(QCustomPlot *plot, int length) {
-    for (int i = 0; i < plot->graphCount(); i++) {
-        QCPGraph *graph = plot->graph(i);
-        while (graph->data()->size() > length) {
-            graph->data()->remove(graph->data()->firstKey());
-        }
+void MainWindow::openScenario() {
+    QString fileName = QFileDialog::getOpenFileName(this, "Open Scenario", QString(),
+                                                    "Scenarios (*.json *.subscn);;All Files (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    Scenario scenario;
+    if (!scenario.load(fileName)) {
+        QMessageBox::warning(this, "Open Scenario", QString("Could not open %1: %2")
+                             .arg(fileName, scenario.errorString()));
+        return;
+    }
+
+    bool wasRunning = m_simulation->isRunning();
+    pauseSimulation();
+
+    QString error;
+    if (!scenario.apply(m_simulation->core(), &error)) {
+        QMessageBox::warning(this, "Open Scenario", QString("Could not apply %1: %2").arg(fileName, error));
+    }
+
+    restartSimulation();
+
+    if (wasRunning) {
+        playSimulation();
+    }
+}
+
+void MainWindow::saveScenario() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Save Scenario", "scenario.json",
+                                                    "JSON Scenario (*.json);;Binary Scenario (*.subscn)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    bool wasRunning = m_simulation->isRunning();
+    pauseSimulation();
+
+    Scenario scenario = Scenario::capture(m_simulation->core());
+
+    if (wasRunning) {
+        playSimulation();
+    }
+
+    Scenario::Format format = fileName.endsWith(".json") ? Scenario::Json : Scenario::Binary;
+    if (!scenario.save(fileName, format)) {
+        QMessageBox::warning(this, "Save Scenario", QString("Could not save to %1: %2")
+                             .arg(fileName, scenario.errorString()));
     }
 }
 
@@ -160,48 +294,45 @@ void clearPlots(QCustomPlot *plot) {
 }
 
 void MainWindow::updateCharts() {
-    Submarine *submarine = m_simulation->submarine();
-    double time = m_simulation->time();
-
-    ui->chartAngle->graph(0)->addData(time, qRadiansToDegrees(submarine->body()->roll()));
-    ui->chartAngle->graph(1)->addData(time, qRadiansToDegrees(submarine->body()->yaw()));
-    ui->chartAngle->graph(2)->addData(time, qRadiansToDegrees(submarine->body()->pitch()));
-    ui->chartAngle->xAxis->rescale();
-    limitChartData(ui->chartAngle, 500);
-    ui->chartAngle->replot();
-
-    ui->chartAngularVelocity->graph(0)->addData(time, qRadiansToDegrees(submarine->body()->angularVelocity().x()));
-    ui->chartAngularVelocity->graph(1)->addData(time, qRadiansToDegrees(submarine->body()->angularVelocity().y()));
-    ui->chartAngularVelocity->graph(2)->addData(time, qRadiansToDegrees(submarine->body()->angularVelocity().z()));
-    ui->chartAngularVelocity->xAxis->rescale();
-    limitChartData(ui->chartAngularVelocity, 500);
-    ui->chartAngularVelocity->replot();
-
-    ui->chartAngleOfAttack->graph(0)->addData(time, qRadiansToDegrees(submarine->body()->rollAngleOfAttack()));
-    ui->chartAngleOfAttack->graph(1)->addData(time, qRadiansToDegrees(submarine->body()->yawAngleOfAttack()));
-    ui->chartAngleOfAttack->graph(2)->addData(time, qRadiansToDegrees(submarine->body()->pitchAngleOfAttack()));
-    ui->chartAngleOfAttack->xAxis->rescale();
-    limitChartData(ui->chartAngleOfAttack, 500);
-    ui->chartAngleOfAttack->replot();
-
-    ui->chartLinearVelocity->graph(0)->addData(time, submarine->body()->linearVelocity().x());
-    ui->chartLinearVelocity->graph(1)->addData(time, submarine->body()->linearVelocity().y());
-    ui->chartLinearVelocity->graph(2)->addData(time, submarine->body()->linearVelocity().z());
-    ui->chartLinearVelocity->xAxis->rescale();
-    limitChartData(ui->chartLinearVelocity, 500);
-    ui->chartLinearVelocity->replot();
-
-    ui->chartPosition->graph(0)->addData(submarine->body()->position().x(), submarine->body()->position().y());
-    ui->chartPosition->graph(1)->addData(submarine->body()->position().x(), submarine->body()->position().z());
-    ui->chartPosition->xAxis->rescale();
-    ui->chartPosition->yAxis->rescale();
-    limitChartData(ui->chartPosition, 2000);
-    ui->chartPosition->replot();
+    TelemetrySample sample;
+    bool added = false;
+
+    while (m_simulation->samples()->pop(&sample)) {
+        addChartSample(sample);
+        added = true;
+    }
+
+    if (added) {
+        m_chartScheduler->markDirty();
+    }
+}
+
+void MainWindow::addChartSample(const TelemetrySample &sample) {
+    double time = sample.time;
+
+    ui->chartAngle->graph(0)->addData(time, qRadiansToDegrees(sample.roll));
+    ui->chartAngle->graph(1)->addData(time, qRadiansToDegrees(sample.yaw));
+    ui->chartAngle->graph(2)->addData(time, qRadiansToDegrees(sample.pitch));
+
+    ui->chartAngularVelocity->graph(0)->addData(time, qRadiansToDegrees(sample.angularVelocity.x()));
+    ui->chartAngularVelocity->graph(1)->addData(time, qRadiansToDegrees(sample.angularVelocity.y()));
+    ui->chartAngularVelocity->graph(2)->addData(time, qRadiansToDegrees(sample.angularVelocity.z()));
+
+    ui->chartAngleOfAttack->graph(0)->addData(time, qRadiansToDegrees(sample.rollAngleOfAttack));
+    ui->chartAngleOfAttack->graph(1)->addData(time, qRadiansToDegrees(sample.yawAngleOfAttack));
+    ui->chartAngleOfAttack->graph(2)->addData(time, qRadiansToDegrees(sample.pitchAngleOfAttack));
+
+    ui->chartLinearVelocity->graph(0)->addData(time, sample.linearVelocity.x());
+    ui->chartLinearVelocity->graph(1)->addData(time, sample.linearVelocity.y());
+    ui->chartLinearVelocity->graph(2)->addData(time, sample.linearVelocity.z());
+
+    ui->chartPosition->graph(0)->addData(sample.position.x(), sample.position.y());
+    ui->chartPosition->graph(1)->addData(sample.position.x(), sample.position.z());
 }
 
 void MainWindow::playSimulation()
 {
-    connect(m_timer, &QTimer::timeout, this, &MainWindow::stepSimulation);
+    m_simulation->play();
 
     ui->actionPlay->setVisible(false);
     ui->actionPause->setVisible(true);
@@ -216,7 +347,7 @@ void MainWindow::playSimulation()
 
 void MainWindow::pauseSimulation()
 {
-    disconnect(m_timer, &QTimer::timeout, this, &MainWindow::stepSimulation);
+    m_simulation->pause();
 
     ui->actionPlay->setVisible(true);
     ui->actionPause->setVisible(false);
@@ -229,14 +360,22 @@ void MainWindow::pauseSimulation()
 #endif
 }
 
-void MainWindow::restartSimulation()
+void MainWindow::clearCharts()
 {
     clearPlots(ui->chartAngle);
     clearPlots(ui->chartAngularVelocity);
+    clearPlots(ui->chartAngleOfAttack);
     clearPlots(ui->chartLinearVelocity);
     clearPlots(ui->chartPosition);
+    m_chartScheduler->markDirty();
+}
+
+void MainWindow::restartSimulation()
+{
+    clearCharts();
 
     m_simulation->reset();
+    ui->actionRecord_Telemetry->setChecked(m_simulation->isRecording());
 
     stepSimulation();
 }
@@ -246,3 +385,138 @@ void MainWindow::stepSimulation()
     m_simulation->step();
     updateCharts();
 }
+
+void MainWindow::updateSimulation()
+{
+    m_simulation->update();
+    updateCharts();
+
+    if (m_simulation->isReplaying()) {
+        updateReplayToolbar();
+
+        // a replay stops by itself at its end
+        if (!m_simulation->isRunning() && ui->actionPause->isVisible()) {
+            pauseSimulation();
+        }
+    }
+}
+
+void MainWindow::saveState() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Save State", "state.substate",
+                                                    "Simulation State (*.substate)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(m_simulation->saveState()) < 0) {
+        QMessageBox::warning(this, "Save State", QString("Could not save to %1: %2")
+                             .arg(fileName, file.errorString()));
+    }
+}
+
+void MainWindow::restoreState() {
+    QString fileName = QFileDialog::getOpenFileName(this, "Restore State", QString(),
+                                                    "Simulation State (*.substate)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        QMessageBox::warning(this, "Restore State", QString("Could not open %1: %2")
+                             .arg(fileName, file.errorString()));
+        return;
+    }
+
+    bool wasRunning = m_simulation->isRunning();
+    pauseSimulation();
+
+    clearCharts();
+
+    if (!m_simulation->restoreState(file.readAll())) {
+        QMessageBox::warning(this, "Restore State", QString("%1 is not a saved simulation state").arg(fileName));
+        restartSimulation();
+    }
+
+    ui->actionRecord_Telemetry->setChecked(m_simulation->isRecording());
+
+    if (wasRunning) {
+        playSimulation();
+    }
+}
+
+void MainWindow::recordTelemetry(bool record) {
+    if (!record) {
+        m_simulation->stopRecording();
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this, "Record Telemetry", "telemetry.subtel",
+                                                    "Telemetry (*.subtel)");
+    if (fileName.isEmpty()) {
+        ui->actionRecord_Telemetry->setChecked(false);
+        return;
+    }
+
+    if (!m_simulation->startRecording(fileName)) {
+        ui->actionRecord_Telemetry->setChecked(false);
+        QMessageBox::warning(this, "Record Telemetry", QString("Could not record to %1: %2")
+                             .arg(fileName, m_simulation->recordingErrorString()));
+    }
+}
+
+void MainWindow::telemetryRecordingStopped(const QString &error) {
+    // already stopped from here, e.g. by a reset
+    if (!m_simulation->isRecording()) {
+        return;
+    }
+
+    m_simulation->stopRecording();
+    ui->actionRecord_Telemetry->setChecked(false);
+    QMessageBox::warning(this, "Record Telemetry", QString("Stopped recording telemetry: %1").arg(error));
+}
+
+void MainWindow::openReplay() {
+    QString fileName = QFileDialog::getOpenFileName(this, "Open Replay", QString(), "Telemetry (*.subtel)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (!m_simulation->openReplay(fileName)) {
+        QMessageBox::warning(this, "Open Replay", QString("Could not open %1: %2")
+                             .arg(fileName, m_simulation->replay()->errorString()));
+        return;
+    }
+
+    m_simulation->replay()->setSpeed(m_replaySpeed->currentData().toDouble());
+
+    ui->actionRecord_Telemetry->setEnabled(false);
+    ui->actionClose_Replay->setEnabled(true);
+    m_replayToolBar->show();
+
+    updateReplayToolbar();
+    playSimulation();
+}
+
+void MainWindow::closeReplay() {
+    m_simulation->closeReplay();
+
+    ui->actionRecord_Telemetry->setEnabled(true);
+    ui->actionClose_Replay->setEnabled(false);
+    m_replayToolBar->hide();
+
+    pauseSimulation();
+}
+
+void MainWindow::seekReplay(int position) {
+    ReplayPlayer *replay = m_simulation->replay();
+    double fraction = double(position) / m_replaySlider->maximum();
+
+    replay->setTime(replay->startTime() + (replay->endTime() - replay->startTime()) * fraction);
+    m_simulation->update();
+}
+
+void MainWindow::changeReplaySpeed(int index) {
+    m_simulation->replay()->setSpeed(m_replaySpeed->itemData(index).toDouble());
+}
@@ -3,9 +3,15 @@
 
 #include <QMainWindow>
 
+class ChartScheduler;
+class QComboBox;
+class QLabel;
+class QSlider;
+class QToolBar;
 class Simulation;
 class QTimer;
 class QMacToolBarItem;
+struct TelemetrySample;
 
 namespace Ui {
 class MainWindow;
@@ -21,22 +27,44 @@ public:
 
 private:
     void initialiseMacToolbar();
+    void addChartSample(const TelemetrySample &sample);
+    void clearCharts();
+    void initialiseReplayToolbar();
+    void updateReplayToolbar();
 
 public slots:
     void showAbout();
     void changeSimulationProperties();
+    void openScenario();
+    void saveScenario();
     void updateCharts();
 
     void playSimulation();
     void pauseSimulation();
     void restartSimulation();
     void stepSimulation();
+    void updateSimulation();
+    void saveState();
+    void restoreState();
+    void recordTelemetry(bool record);
+    void telemetryRecordingStopped(const QString &error);
+
+    void openReplay();
+    void closeReplay();
+    void seekReplay(int position);
+    void changeReplaySpeed(int index);
 
 private:
     Ui::MainWindow *ui;
     Simulation *m_simulation;
     QWidget *m_simulationWidget;
     QTimer *m_timer;
+    ChartScheduler *m_chartScheduler;
+
+    QToolBar *m_replayToolBar;
+    QSlider *m_replaySlider;
+    QComboBox *m_replaySpeed;
+    QLabel *m_replayTime;
 
 #ifdef Q_OS_OSX
     QMacToolBarItem *m_playPauseItem;
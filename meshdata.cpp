@@ -0,0 +1,222 @@
+#include <QFile>
+#include <QHash>
+#include <QResource>
+#include <QString>
+#include <QVector3D>
+#include <QVector>
+
+#include <cstring>
+
+#include "meshformat.h"
+
+#include "meshdata.h"
+
+namespace {
+
+// an OBJ index, counted from one, or back from the end when negative
+int resolveIndex(const QByteArray &index, int count)
+{
+    bool ok;
+    int i = index.toInt(&ok);
+
+    if (!ok || i == 0) {
+        return -1;
+    }
+
+    i = i > 0 ? i - 1 : count + i;
+    return i < count ? i : -1;
+}
+
+// points mesh at the vertices and indices of a compiled mesh in memory
+bool useMesh(const uchar *data, qint64 size, MeshData *mesh, QString *error)
+{
+    MeshFormat::Header header;
+    if (size < qint64(sizeof(header))) {
+        *error = "Not a mesh file";
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, MeshFormat::Magic, sizeof(header.magic)) != 0) {
+        *error = "Not a mesh file";
+        return false;
+    }
+
+    if (header.version != MeshFormat::Version) {
+        *error = QString("Unsupported mesh version %1").arg(header.version);
+        return false;
+    }
+
+    qint64 verticesSize = qint64(header.vertexCount) * MeshData::VertexSize;
+    qint64 indicesSize = qint64(header.indexCount) * MeshData::IndexSize;
+    if (size < qint64(sizeof(header)) + verticesSize + indicesSize) {
+        *error = "Truncated mesh file";
+        return false;
+    }
+
+    const char *vertices = reinterpret_cast<const char *>(data) + sizeof(header);
+
+    mesh->vertices = QByteArray::fromRawData(vertices, verticesSize);
+    mesh->vertexCount = header.vertexCount;
+    mesh->indices = QByteArray::fromRawData(vertices + verticesSize, indicesSize);
+    mesh->indexCount = header.indexCount;
+
+    return true;
+}
+
+// appends the index of the vertex with position and normal, adding the
+// vertex the first time it is seen
+void appendVertex(QVector<float> *vertices, QVector<quint32> *indices, QHash<QByteArray, quint32> *seen,
+                  const QVector3D &position, const QVector3D &normal)
+{
+    const float vertex[6] = { position.x(), position.y(), position.z(), normal.x(), normal.y(), normal.z() };
+    QByteArray key(reinterpret_cast<const char *>(vertex), sizeof(vertex));
+
+    auto it = seen->find(key);
+    if (it == seen->end()) {
+        it = seen->insert(key, vertices->size() / 6);
+
+        for (float value : vertex) {
+            vertices->append(value);
+        }
+    }
+
+    indices->append(*it);
+}
+
+}
+
+bool readObj(const QString &fileName, MeshData *mesh, QString *error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+
+    QVector<QVector3D> positions;
+    QVector<QVector3D> normals;
+    QVector<float> vertices;
+    QVector<quint32> indices;
+    QHash<QByteArray, quint32> seen;
+
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().simplified();
+        lineNumber++;
+
+        QList<QByteArray> fields = line.split(' ');
+        const QByteArray &type = fields.first();
+
+        if (type == "v" || type == "vn") {
+            if (fields.size() < 4) {
+                *error = QString("Invalid vertex on line %1").arg(lineNumber);
+                return false;
+            }
+
+            QVector3D v(fields[1].toFloat(), fields[2].toFloat(), fields[3].toFloat());
+            (type == "v" ? positions : normals).append(v);
+        } else if (type == "f") {
+            // each corner is v, v/vt, v//vn or v/vt/vn
+            QVector<QVector3D> cornerPositions;
+            QVector<QVector3D> cornerNormals;
+
+            for (int i = 1; i < fields.size(); i++) {
+                QList<QByteArray> indices = fields[i].split('/');
+
+                int position = resolveIndex(indices[0], positions.size());
+                int normal = indices.size() > 2 ? resolveIndex(indices[2], normals.size()) : -1;
+
+                if (position < 0) {
+                    *error = QString("Invalid face on line %1").arg(lineNumber);
+                    return false;
+                }
+
+                cornerPositions.append(positions[position]);
+                cornerNormals.append(normal >= 0 ? normals[normal] : QVector3D());
+            }
+
+            if (cornerPositions.size() < 3) {
+                *error = QString("Invalid face on line %1").arg(lineNumber);
+                return false;
+            }
+
+            QVector3D flatNormal = QVector3D::normal(cornerPositions[0], cornerPositions[1], cornerPositions[2]);
+            for (QVector3D &normal : cornerNormals) {
+                if (normal.isNull()) {
+                    normal = flatNormal;
+                }
+            }
+
+            for (int i = 2; i < cornerPositions.size(); i++) {
+                appendVertex(&vertices, &indices, &seen, cornerPositions[0], cornerNormals[0]);
+                appendVertex(&vertices, &indices, &seen, cornerPositions[i - 1], cornerNormals[i - 1]);
+                appendVertex(&vertices, &indices, &seen, cornerPositions[i], cornerNormals[i]);
+            }
+        }
+    }
+
+    mesh->vertices = QByteArray(reinterpret_cast<const char *>(vertices.constData()),
+                                vertices.size() * sizeof(float));
+    mesh->vertexCount = vertices.size() / 6;
+    mesh->indices = QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                               indices.size() * sizeof(quint32));
+    mesh->indexCount = indices.size();
+
+    return true;
+}
+
+bool writeMesh(const QString &fileName, const MeshData &mesh, QString *error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = file.errorString();
+        return false;
+    }
+
+    MeshFormat::Header header;
+    memcpy(header.magic, MeshFormat::Magic, sizeof(header.magic));
+    header.version = MeshFormat::Version;
+    header.vertexCount = mesh.vertexCount;
+    header.indexCount = mesh.indexCount;
+    header.reserved = 0;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(mesh.vertices);
+    file.write(mesh.indices);
+
+    if (file.error() != QFile::NoError) {
+        *error = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool mapMesh(const QString &fileName, MeshData *mesh, QString *error)
+{
+    // an uncompressed resource is already in memory, as part of the
+    // executable; anything else is mapped from its file
+    QResource resource(fileName);
+    if (resource.isValid() && !resource.isCompressed()) {
+        return useMesh(resource.data(), resource.size(), mesh, error);
+    }
+
+    QFile *file = new QFile(fileName);
+    const uchar *data = 0;
+
+    if (!file->open(QIODevice::ReadOnly) || !(data = file->map(0, file->size()))) {
+        *error = file->errorString();
+        delete file;
+        return false;
+    }
+
+    if (!useMesh(data, file->size(), mesh, error)) {
+        delete file;
+        return false;
+    }
+
+    // the file is never closed, which would unmap it
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef MESHDATA_H
+#define MESHDATA_H
+
+#include <QByteArray>
+
+class QString;
+
+// A mesh as indexed triangles, each vertex a position followed by a normal
+// and each index a quint32, ready to be used as vertex and index buffers as
+// they are.
+struct MeshData
+{
+    MeshData() :
+        vertexCount(0),
+        indexCount(0)
+    {
+
+    }
+
+    static const int VertexSize = 6 * sizeof(float);
+    static const int IndexSize = sizeof(quint32);
+
+    QByteArray vertices;
+    int vertexCount;
+    QByteArray indices;
+    int indexCount;
+};
+
+// reads the vertices, normals and faces of a Wavefront OBJ file; faces are
+// triangulated as fans, ones without normals get flat normals and corners
+// with the same position and normal share a vertex
+bool readObj(const QString &fileName, MeshData *mesh, QString *error);
+
+// writes and maps compiled mesh files, see meshformat.h. A mapped mesh's
+// vertices and indices point straight into the resource or file, which stays mapped
+// for the life of the process.
+bool writeMesh(const QString &fileName, const MeshData &mesh, QString *error);
+bool mapMesh(const QString &fileName, MeshData *mesh, QString *error);
+
+#endif // MESHDATA_H
@@ -0,0 +1,43 @@
+# Compiles the OBJ models to binary meshes with meshconvert, which is built
+# first, and embeds them uncompressed so that they can be used in place.
+# AssetCache falls back to the OBJ files in resources.qrc without them.
+
+MESH_SOURCES = \
+    $$PWD/models/arrow.obj \
+    $$PWD/models/fin.obj \
+    $$PWD/models/propellor.obj \
+    $$PWD/models/torque-arrow.obj
+
+MESH_CONVERTER_DIR = $$OUT_PWD/tools/meshconvert
+MESH_CONVERTER = $$MESH_CONVERTER_DIR/meshconvert
+win32: MESH_CONVERTER = $${MESH_CONVERTER}.exe
+
+meshconvert.target = $$MESH_CONVERTER
+meshconvert.commands = $$sprintf($$QMAKE_MKDIR_CMD, $$shell_path($$MESH_CONVERTER_DIR)) && \
+    cd $$shell_path($$MESH_CONVERTER_DIR) && \
+    $$QMAKE_QMAKE $$shell_path($$PWD/tools/meshconvert/meshconvert.pro) && \
+    $(MAKE)
+meshconvert.depends = $$PWD/meshdata.cpp $$PWD/meshdata.h $$PWD/meshformat.h $$PWD/tools/meshconvert/main.cpp
+QMAKE_EXTRA_TARGETS += meshconvert
+
+meshes.input = MESH_SOURCES
+meshes.output = $$OUT_PWD/models/${QMAKE_FILE_BASE}.mesh
+meshes.commands = $$shell_path($$MESH_CONVERTER) ${QMAKE_FILE_IN} ${QMAKE_FILE_OUT}
+meshes.depends = $$MESH_CONVERTER
+meshes.CONFIG += no_link target_predeps
+QMAKE_EXTRA_COMPILERS += meshes
+
+# the resource file listing them is generated here, so that it can name
+# the build directory. rcc compresses a file when that saves more than its
+# threshold percentage, and a compressed mesh would have to be unpacked to
+# be used, so the meshes' threshold is one no file can reach
+MESH_RESOURCES = "<RCC>" "    <qresource prefix=\"/models\">"
+for (source, MESH_SOURCES) {
+    mesh = $$basename(source)
+    mesh = $$replace(mesh, \\.obj$, .mesh)
+    MESH_RESOURCES += "        <file alias=\"$$mesh\" threshold=\"100\">$$OUT_PWD/models/$$mesh</file>"
+}
+MESH_RESOURCES += "    </qresource>" "</RCC>"
+
+write_file($$OUT_PWD/meshes.qrc, MESH_RESOURCES)
+RESOURCES += $$OUT_PWD/meshes.qrc
@@ -0,0 +1,36 @@
+#ifndef MESHFORMAT_H
+#define MESHFORMAT_H
+
+#include <QtGlobal>
+
+// A compiled mesh file is laid out as
+//
+//   MeshFormat::Header
+//   float vertices[vertexCount][6]
+//   quint32 indices[indexCount]
+//
+// with everything little endian, each vertex a position followed by its
+// normal, stored once however many triangles share it, and every three
+// indices a triangle: exactly a MeshData, so that it can be used in place,
+// without parsing. meshconvert compiles OBJ files to it at build time.
+
+namespace MeshFormat {
+
+const char Magic[8] = { 'S', 'U', 'B', 'M', 'E', 'S', 'H', '\0' };
+const quint32 Version = 2;
+
+struct Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 vertexCount;
+    quint32 indexCount;
+    quint32 reserved;  // zero, keeping the vertices 8 byte aligned
+};
+
+Q_STATIC_ASSERT(sizeof(Header) == 24);
+Q_STATIC_ASSERT(Q_BYTE_ORDER == Q_LITTLE_ENDIAN);
+
+} // namespace MeshFormat
+
+#endif // MESHFORMAT_H
@@ -20,121 +20,145 @@ float wrapAngle(float angle)
     return angle;
 }
 
+float angleOfAttack(float angle, const QVector2D &velocity)
+{
+    float velocityAngle = wrapAngle(atan2(velocity.y(), velocity.x()));
+    return wrapAngle(angle - velocityAngle);
+}
+
 Body::Body(btRigidBody *body, QObject *parent) :
     QObject(parent),
     m_body(body)
 {
-
+    updateKinematics();
 }
 
 Body::~Body()
 {
+    delete m_body->getMotionState();
     delete m_body;
 }
 
-btRigidBody *Body::body() const
+void Body::updateKinematics()
 {
-    return m_body;
+    updateKinematics(m_kinematics.current);
 }
 
-double Body::mass() const
+void Body::updateKinematics(const QVector3D &current)
 {
-    return 1. / m_body->getInvMass();
-}
+    const btTransform &transform = m_body->getCenterOfMassTransform();
 
-double Body::pitch() const
-{
-    btTransform transform = m_body->getCenterOfMassTransform();
+    m_kinematics.mass = 1. / m_body->getInvMass();
 
-    btMatrix3x3 basis = transform.getBasis();
+    btVector3 p = transform.getOrigin();
+    m_kinematics.position = QVector3D(p.x(), p.y(), p.z());
 
-    float yaw, pitch, roll;
-    // yes, those do appear to be in the wrong order, but it is correct
-    basis.getEulerYPR(pitch, yaw, roll);
+    btQuaternion q = transform.getRotation();
+    m_kinematics.rotation = QQuaternion(q.w(), q.x(), q.y(), q.z());
 
-    return wrapAngle(pitch);
-}
+    btVector3 groundVelocity = m_body->getLinearVelocity();
+    m_kinematics.linearVelocity = QVector3D(groundVelocity.x(), groundVelocity.y(), groundVelocity.z());
 
-double Body::yaw() const
-{
-    btTransform transform = m_body->getCenterOfMassTransform();
+    m_kinematics.current = current;
+    m_kinematics.relativeVelocity = m_kinematics.linearVelocity - current;
+    const QVector3D &v = m_kinematics.relativeVelocity;
 
-    btMatrix3x3 basis = transform.getBasis();
+    btVector3 w = m_body->getAngularVelocity();
+    m_kinematics.angularVelocity = QVector3D(w.x(), w.y(), w.z());
 
     float yaw, pitch, roll;
     // yes, those do appear to be in the wrong order, but it is correct
-    basis.getEulerYPR(pitch, yaw, roll);
+    transform.getBasis().getEulerYPR(pitch, yaw, roll);
+
+    m_kinematics.pitch = wrapAngle(pitch);
+    m_kinematics.yaw = wrapAngle(yaw);
+    m_kinematics.roll = wrapAngle(roll);
 
-    return wrapAngle(yaw);
+    m_kinematics.pitchVelocity = QVector2D(v.x(), v.y());
+    m_kinematics.yawVelocity = QVector2D(v.x(), v.z());
+    m_kinematics.rollVelocity = QVector2D(v.y(), v.z());
+
+    m_kinematics.pitchAngleOfAttack = angleOfAttack(m_kinematics.pitch, m_kinematics.pitchVelocity);
+    m_kinematics.yawAngleOfAttack = angleOfAttack(m_kinematics.yaw, m_kinematics.yawVelocity);
+    m_kinematics.rollAngleOfAttack = angleOfAttack(m_kinematics.roll, m_kinematics.rollVelocity);
 }
 
-double Body::roll() const
+const KinematicState &Body::kinematics() const
 {
-    btTransform transform = m_body->getCenterOfMassTransform();
+    return m_kinematics;
+}
 
-    btMatrix3x3 basis = transform.getBasis();
+btRigidBody *Body::body() const
+{
+    return m_body;
+}
 
-    float yaw, pitch, roll;
+double Body::mass() const
+{
+    return m_kinematics.mass;
+}
 
-    // yes, those do appear to be in the wrong order, but I'm sure it is correct
-    basis.getEulerYPR(pitch, yaw, roll);
+double Body::pitch() const
+{
+    return m_kinematics.pitch;
+}
 
-    return wrapAngle(roll);
+double Body::yaw() const
+{
+    return m_kinematics.yaw;
+}
+
+double Body::roll() const
+{
+    return m_kinematics.roll;
 }
 
 QVector2D Body::pitchVelocity() const
 {
-    btVector3 velocity = m_body->getLinearVelocity();
-    return QVector2D(velocity.x(), velocity.y());
+    return m_kinematics.pitchVelocity;
 }
 
 QVector2D Body::yawVelocity() const
 {
-    btVector3 velocity = m_body->getLinearVelocity();
-    return QVector2D(velocity.x(), velocity.z());
+    return m_kinematics.yawVelocity;
 }
 
 QVector2D Body::rollVelocity() const
 {
-    btVector3 velocity = m_body->getLinearVelocity();
-    return QVector2D(velocity.y(), velocity.z());
+    return m_kinematics.rollVelocity;
 }
 
 double Body::pitchAngleOfAttack() const
 {
-    QVector2D velocity = pitchVelocity();
-    float velocityAngle = wrapAngle(atan2(velocity.y(), velocity.x()));
-    return wrapAngle(pitch() - velocityAngle);
+    return m_kinematics.pitchAngleOfAttack;
 }
 
 double Body::yawAngleOfAttack() const
 {
-    QVector2D velocity = yawVelocity();
-    float velocityAngle = wrapAngle(atan2(velocity.y(), velocity.x()));
-    return wrapAngle(yaw() - velocityAngle);
+    return m_kinematics.yawAngleOfAttack;
 }
 
 double Body::rollAngleOfAttack() const
 {
-    QVector2D velocity = rollVelocity();
-    float velocityAngle = wrapAngle(atan2(velocity.y(), velocity.x()));
-    return wrapAngle(roll() - velocityAngle);
+    return m_kinematics.rollAngleOfAttack;
 }
 
 QVector3D Body::angularVelocity() const
 {
-    btVector3 v = m_body->getAngularVelocity();
-    return QVector3D(v.x(), v.y(), v.z());
+    return m_kinematics.angularVelocity;
 }
 
 QVector3D Body::linearVelocity() const
 {
-    btVector3 v = m_body->getLinearVelocity();
-    return QVector3D(v.x(), v.y(), v.z());
+    return m_kinematics.linearVelocity;
 }
 
 QVector3D Body::position() const
 {
-    btVector3 p = m_body->getCenterOfMassPosition();
-    return QVector3D(p.x(), p.y(), p.z());
+    return m_kinematics.position;
+}
+
+QQuaternion Body::rotation() const
+{
+    return m_kinematics.rotation;
 }
@@ -2,11 +2,54 @@
 #define BODY_H
 
 #include <QObject>
+#include <QQuaternion>
+#include <QVector2D>
+#include <QVector3D>
 
 class btRigidBody;
 
 namespace Physics {
 
+struct KinematicState
+{
+    KinematicState() :
+        mass(0),
+        pitch(0),
+        yaw(0),
+        roll(0),
+        pitchAngleOfAttack(0),
+        yawAngleOfAttack(0),
+        rollAngleOfAttack(0)
+    {
+
+    }
+
+    double mass;
+
+    QVector3D position;
+    QQuaternion rotation;
+
+    QVector3D linearVelocity;
+    QVector3D angularVelocity;
+
+    // the water's velocity at the body, and the body's velocity through it;
+    // everything below is relative to the water
+    QVector3D current;
+    QVector3D relativeVelocity;
+
+    double pitch;
+    double yaw;
+    double roll;
+
+    QVector2D pitchVelocity;
+    QVector2D yawVelocity;
+    QVector2D rollVelocity;
+
+    double pitchAngleOfAttack;
+    double yawAngleOfAttack;
+    double rollAngleOfAttack;
+};
+
 class Body : public QObject
 {
     Q_OBJECT
@@ -15,6 +58,10 @@ public:
     explicit Body(btRigidBody *body, QObject *parent = 0);
     ~Body();
 
+    void updateKinematics();
+    void updateKinematics(const QVector3D &current);
+    const KinematicState &kinematics() const;
+
     btRigidBody *body() const;
 
     double mass() const;
@@ -34,11 +81,13 @@ public:
     QVector3D angularVelocity() const;
     QVector3D linearVelocity() const;
     QVector3D position() const;
+    QQuaternion rotation() const;
 
     Q_PROPERTY(btRigidBody *body READ body)
 
 private:
     btRigidBody *m_body;
+    KinematicState m_kinematics;
 };
 
 }
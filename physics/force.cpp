@@ -1,6 +1,4 @@
 #include <QtDebug>
-#include <QtMath>
-#include <QVector2D>
 
 #include <bullet/btBulletDynamicsCommon.h>
 
@@ -18,23 +16,6 @@ Force::Force(QString name, QObject *parent) :
 
 }
 
-void Force::apply()
-{
-    if (!m_body) {
-        qCritical() << "Body not set on force:" << m_name;
-        return;
-    }
-
-    calculate();
-
-    btVector3 force = btVector3(m_force.x(), m_force.y(), m_force.z());
-    btVector3 localPosition = btVector3(m_localPosition.x(), m_localPosition.y(), m_localPosition.z());
-
-    m_body->body()->applyForce(force, localPosition);
-
-    emit applied();
-}
-
 QString Force::name() const
 {
     return m_name;
@@ -85,17 +66,6 @@ WeightForce::WeightForce(QObject *parent) :
 
 }
 
-void WeightForce::calculate()
-{
-    btTransform transform = m_body->body()->getCenterOfMassTransform();
-;
-    m_force = QVector3D(0, -9.81 * m_body->mass(), 0);
-
-    btVector3 position(m_position.x(), m_position.y(), m_position.z());
-    btVector3 localPosition = (transform * position) - transform.getOrigin();
-    m_localPosition = QVector3D(localPosition.x(), localPosition.y(), localPosition.z());
-}
-
 QVector3D WeightForce::position() const
 {
     return m_position;
@@ -112,17 +82,6 @@ BuoyancyForce::BuoyancyForce(QObject *parent) :
 
 }
 
-void BuoyancyForce::calculate()
-{
-    btTransform transform = m_body->body()->getCenterOfMassTransform();
-
-    m_force = QVector3D(0, 9.81 * m_body->mass(), 0);
-
-    btVector3 position(m_position.x(), m_position.y(), m_position.z());
-    btVector3 localPosition = (transform * position) - transform.getOrigin();
-    m_localPosition = QVector3D(localPosition.x(), localPosition.y(), localPosition.z());
-}
-
 QVector3D BuoyancyForce::position() const
 {
     return m_position;
@@ -139,20 +98,6 @@ ThrustForce::ThrustForce(QObject *parent) :
 
 }
 
-void ThrustForce::calculate()
-{
-    btTransform transform = m_body->body()->getCenterOfMassTransform();
-
-    btVector3 value(m_value.x(), m_value.y(), m_value.z());
-    btVector3 localValue = (transform * value) - transform.getOrigin();
-
-    btVector3 position(m_position.x(), m_position.y(), m_position.z());
-    btVector3 localPosition = (transform * position) - transform.getOrigin();
-
-    m_force = QVector3D(localValue.x(), localValue.y(), localValue.z());
-    m_localPosition = QVector3D(localPosition.x(), localPosition.y(), localPosition.z());
-}
-
 QVector3D ThrustForce::value() const
 {
     return m_value;
@@ -179,35 +124,6 @@ DragForce::DragForce(QObject *parent) :
 
 }
 
-void DragForce::calculate()
-{
-    btTransform transform = m_body->body()->getCenterOfMassTransform();
-
-    btVector3 velocity = m_body->body()->getLinearVelocity();
-    if (velocity.length() == 0) {
-        return;  // can't be normalised
-    }
-
-    float value = 0.5f * m_fluidDensity * m_crossSectionalArea * m_coefficient * velocity.length2();
-    btVector3 force = velocity.normalized() * -value;
-
-    m_force = QVector3D(force.x(), force.y(), force.z());
-
-    btVector3 position(m_position.x(), m_position.y(), m_position.z());
-    btVector3 localPosition = (transform * position) - transform.getOrigin();
-    m_localPosition = QVector3D(localPosition.x(), localPosition.y(), localPosition.z());
-}
-
-double DragForce::fluidDensity() const
-{
-    return m_fluidDensity;
-}
-
-void DragForce::setFluidDensity(double fluidDensity)
-{
-    m_fluidDensity = fluidDensity;
-}
-
 double DragForce::crossSectionalArea() const
 {
     return m_crossSectionalArea;
@@ -244,60 +160,6 @@ LiftForce::LiftForce(QObject *parent) :
 
 }
 
-QVector2D calculateLift(float fluidDensity, float angleOfAttack, float liftCoefficientSlope, float area, QVector2D velocity)
-{
-    float liftCoefficient = angleOfAttack * liftCoefficientSlope;
-
-    float value = 0.5f * fluidDensity * area * liftCoefficient * velocity.lengthSquared();
-
-    QVector2D result = velocity.normalized();
-
-    // rotate90(1)
-    float x = result.x();
-    result.setX(-result.y());
-    result.setY(x);
-
-    return result * value;
-}
-
-void LiftForce::calculate()
-{
-    m_force = QVector3D();
-
-    // pitch
-    QVector2D pitchVelocity = m_body->pitchVelocity();
-    float pitchAngleOfAttack = m_body->pitchAngleOfAttack();
-
-    if (qAbs(pitchAngleOfAttack) < qDegreesToRadians(15.)) {
-        QVector2D pitchLift = calculateLift(m_fluidDensity, pitchAngleOfAttack, m_coefficientSlope, m_pitchCrossSectionalArea, pitchVelocity);
-        m_force += QVector3D(pitchLift.x(), pitchLift.y(), 0);
-    }
-
-    // yaw
-    QVector2D yawVelocity = m_body->yawVelocity();
-    float yawAngleOfAttack = m_body->yawAngleOfAttack();
-
-    if (qAbs(yawAngleOfAttack) < qDegreesToRadians(15.)) {
-        QVector2D yawLift = calculateLift(m_fluidDensity, yawAngleOfAttack, m_coefficientSlope, m_yawCrossSectionalArea, yawVelocity);
-        m_force += QVector3D(yawLift.x(), 0, yawLift.y());
-    }
-
-    btTransform transform = m_body->body()->getCenterOfMassTransform();
-    btVector3 position(m_position.x(), m_position.y(), m_position.z());
-    btVector3 localPosition = (transform * position) - transform.getOrigin();
-    m_localPosition = QVector3D(localPosition.x(), localPosition.y(), localPosition.z());
-}
-
-double LiftForce::fluidDensity() const
-{
-    return m_fluidDensity;
-}
-
-void LiftForce::setFluidDensity(double fluidDensity)
-{
-    m_fluidDensity = fluidDensity;
-}
-
 double LiftForce::yawCrossSectionalArea() const
 {
     return m_yawCrossSectionalArea;
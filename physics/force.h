@@ -15,12 +15,6 @@ class Force : public QObject
 public:
     explicit Force(QString name, QObject *parent = 0);
 
-    void apply();
-
-protected:
-    virtual void calculate() = 0;
-
-public:
     QString name() const;
     void setName(const QString &name);
 
@@ -38,9 +32,6 @@ public:
     Q_PROPERTY(QVector3D worldPosition READ worldPosition STORED false)
     Q_PROPERTY(QVector3D force READ force)
 
-signals:
-    void applied();
-
 protected:
     QString m_name;
 
@@ -48,6 +39,8 @@ protected:
 
     QVector3D m_localPosition;
     QVector3D m_force;
+
+    friend class ForcePipeline;
 };
 
 class WeightForce : public Force
@@ -57,13 +50,11 @@ class WeightForce : public Force
 public:
     explicit WeightForce(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
     QVector3D position() const;
     void setPosition(const QVector3D &position);
 
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+
 private:
     QVector3D m_position;
 };
@@ -75,13 +66,11 @@ class BuoyancyForce : public Force
 public:
     explicit BuoyancyForce(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
     QVector3D position() const;
     void setPosition(const QVector3D &position);
 
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+
 private:
     QVector3D m_position;
 };
@@ -93,16 +82,15 @@ class ThrustForce : public Force
 public:
     explicit ThrustForce(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
     QVector3D value() const;
     void setValue(const QVector3D &value);
 
     QVector3D position() const;
     void setPosition(const QVector3D &position);
 
+    Q_PROPERTY(QVector3D value READ value WRITE setValue)
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+
 private:
     QVector3D m_value;
     QVector3D m_position;
@@ -115,13 +103,6 @@ class DragForce : public Force
 public:
     explicit DragForce(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
-    double fluidDensity() const;
-    void setFluidDensity(double fluidDensity);
-
     double crossSectionalArea() const;
     void setCrossSectionalArea(double crossSectionalArea);
 
@@ -131,8 +112,11 @@ public:
     QVector3D position() const;
     void setPosition(const QVector3D &position);
 
+    Q_PROPERTY(double crossSectionalArea READ crossSectionalArea WRITE setCrossSectionalArea)
+    Q_PROPERTY(double coefficient READ coefficient WRITE setCoefficient)
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+
 private:
-    double m_fluidDensity;
     double m_crossSectionalArea;
     double m_coefficient;
     QVector3D m_position;
@@ -145,13 +129,6 @@ class LiftForce : public Force
 public:
     explicit LiftForce(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
-    double fluidDensity() const;
-    void setFluidDensity(double fluidDensity);
-
     double yawCrossSectionalArea() const;
     void setYawCrossSectionalArea(double yawCrossSectionalArea);
 
@@ -164,8 +141,12 @@ public:
     QVector3D position() const;
     void setPosition(const QVector3D &position);
 
+    Q_PROPERTY(double yawCrossSectionalArea READ yawCrossSectionalArea WRITE setYawCrossSectionalArea)
+    Q_PROPERTY(double pitchCrossSectionalArea READ pitchCrossSectionalArea WRITE setPitchCrossSectionalArea)
+    Q_PROPERTY(double coefficientSlope READ coefficientSlope WRITE setCoefficientSlope)
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+
 private:
-    double m_fluidDensity;
     double m_yawCrossSectionalArea;
     double m_pitchCrossSectionalArea;
     double m_coefficientSlope;
@@ -0,0 +1,408 @@
+#include <QDataStream>
+#include <QtDebug>
+#include <QtMath>
+
+#include <algorithm>
+
+#include <bullet/btBulletDynamicsCommon.h>
+
+#include "fluid.h"
+#include "physics/body.h"
+#include "physics/force.h"
+#include "physics/torque.h"
+
+#include "physics/forcepipeline.h"
+
+using namespace Physics;
+
+void ForcePipeline::Vector3Array::clear()
+{
+    x.resize(0);
+    y.resize(0);
+    z.resize(0);
+}
+
+void ForcePipeline::Vector3Array::append(const QVector3D &v)
+{
+    x.append(v.x());
+    y.append(v.y());
+    z.append(v.z());
+}
+
+void ForcePipeline::Vector3Array::resize(int size)
+{
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+}
+
+ForcePipeline::ForcePipeline() :
+    m_worldForcesEnd(0),
+    m_bodyForcesEnd(0),
+    m_dragForcesEnd(0),
+    m_constantTorquesEnd(0),
+    m_spinningDragTorquesEnd(0)
+{
+
+}
+
+void ForcePipeline::compile(const QVector<Force *> &forces, const QVector<Torque *> &torques)
+{
+    QVector<Force *> worldForces, bodyForces, dragForces, liftForces;
+
+    for (Force *force : forces) {
+        if (qobject_cast<WeightForce *>(force) || qobject_cast<BuoyancyForce *>(force)) {
+            worldForces.append(force);
+        } else if (qobject_cast<ThrustForce *>(force)) {
+            bodyForces.append(force);
+        } else if (qobject_cast<DragForce *>(force)) {
+            dragForces.append(force);
+        } else if (qobject_cast<LiftForce *>(force)) {
+            liftForces.append(force);
+        } else {
+            qCritical() << "Force can't be compiled:" << force->name();
+        }
+    }
+
+    m_forces.resize(0);
+    m_forcePositions.clear();
+    m_forceValues.clear();
+    m_dragCoefficients.resize(0);
+    m_liftPitchCoefficients.resize(0);
+    m_liftYawCoefficients.resize(0);
+
+    for (Force *force : worldForces) {
+        double weight = 9.81 * force->body()->mass();
+
+        if (auto buoyancy = qobject_cast<BuoyancyForce *>(force)) {
+            m_forceValues.append(QVector3D(0, weight, 0));
+            m_forcePositions.append(buoyancy->position());
+        } else {
+            m_forceValues.append(QVector3D(0, -weight, 0));
+            m_forcePositions.append(static_cast<WeightForce *>(force)->position());
+        }
+
+        m_forces.append(force);
+    }
+
+    m_worldForcesEnd = m_forces.size();
+
+    for (Force *force : bodyForces) {
+        auto thrust = static_cast<ThrustForce *>(force);
+
+        m_forceValues.append(thrust->value());
+        m_forcePositions.append(thrust->position());
+        m_forces.append(force);
+    }
+
+    m_bodyForcesEnd = m_forces.size();
+
+    for (Force *force : dragForces) {
+        auto drag = static_cast<DragForce *>(force);
+
+        m_dragCoefficients.append(0.5 * drag->crossSectionalArea() * drag->coefficient());
+        m_forcePositions.append(drag->position());
+        m_forces.append(force);
+    }
+
+    m_dragForcesEnd = m_forces.size();
+
+    for (Force *force : liftForces) {
+        auto lift = static_cast<LiftForce *>(force);
+
+        m_liftPitchCoefficients.append(0.5 * lift->pitchCrossSectionalArea() * lift->coefficientSlope());
+        m_liftYawCoefficients.append(0.5 * lift->yawCrossSectionalArea() * lift->coefficientSlope());
+        m_forcePositions.append(lift->position());
+        m_forces.append(force);
+    }
+
+    m_forceDensities.resize(m_forces.size());
+    m_forceResults.resize(m_forces.size());
+    m_positionResults.resize(m_forces.size());
+
+    QVector<Torque *> constantTorques, spinningDragTorques, dampingTorques;
+
+    for (Torque *torque : torques) {
+        if (qobject_cast<PropellorTorque *>(torque)) {
+            constantTorques.append(torque);
+        } else if (qobject_cast<SpinningDragTorque *>(torque)) {
+            spinningDragTorques.append(torque);
+        } else if (qobject_cast<FinDampingTorque *>(torque)) {
+            dampingTorques.append(torque);
+        } else {
+            qCritical() << "Torque can't be compiled:" << torque->name();
+        }
+    }
+
+    m_torques.resize(0);
+    m_torqueValues.clear();
+    m_spinningDragPitchCoefficients.resize(0);
+    m_spinningDragYawCoefficients.resize(0);
+    m_dampingCoefficients.resize(0);
+    m_dampingPositions.clear();
+
+    for (Torque *torque : constantTorques) {
+        m_torqueValues.append(torque->value());
+        m_torques.append(torque);
+    }
+
+    m_constantTorquesEnd = m_torques.size();
+
+    for (Torque *torque : spinningDragTorques) {
+        auto spinningDrag = static_cast<SpinningDragTorque *>(torque);
+
+        double k = 0.5 * spinningDrag->coefficient() / spinningDrag->bodyLength();
+        m_spinningDragPitchCoefficients.append(k * spinningDrag->pitchCrossSectionalArea());
+        m_spinningDragYawCoefficients.append(k * spinningDrag->yawCrossSectionalArea());
+        m_torques.append(torque);
+    }
+
+    m_spinningDragTorquesEnd = m_torques.size();
+
+    for (Torque *torque : dampingTorques) {
+        auto damping = static_cast<FinDampingTorque *>(torque);
+
+        double area = damping->crossSectionalArea();
+        double radius = damping->radius();
+        double span = qSqrt(damping->aspectRatio() * area);
+
+        m_dampingCoefficients.append(2. * area * (radius + span) * (radius + span) * (radius + span / 2.));
+        m_dampingPositions.append(damping->position());
+        m_torques.append(torque);
+    }
+
+    m_torqueResults.resize(m_torques.size());
+}
+
+void ForcePipeline::evaluate(const Body *body, const Fluid *fluid, double time)
+{
+    evaluateForces(body, fluid, time);
+    evaluateTorques(body, fluid, time);
+
+    btRigidBody *rigidBody = body->body();
+    rigidBody->applyCentralForce(btVector3(m_netForce.x(), m_netForce.y(), m_netForce.z()));
+    rigidBody->applyTorque(btVector3(m_netTorque.x(), m_netTorque.y(), m_netTorque.z()));
+}
+
+void ForcePipeline::evaluateForces(const Body *body, const Fluid *fluid, double time)
+{
+    const KinematicState &state = body->kinematics();
+    const btMatrix3x3 &basis = body->body()->getCenterOfMassTransform().getBasis();
+
+    const int count = m_forces.size();
+
+    float *fx = m_forceResults.x.data();
+    float *fy = m_forceResults.y.data();
+    float *fz = m_forceResults.z.data();
+
+    float *rx = m_positionResults.x.data();
+    float *ry = m_positionResults.y.data();
+    float *rz = m_positionResults.z.data();
+
+    // every force acts at a body-fixed point, rotated into the world frame
+    for (int i = 0; i < count; i++) {
+        btVector3 r = basis * btVector3(m_forcePositions.x[i], m_forcePositions.y[i], m_forcePositions.z[i]);
+        rx[i] = r.x();
+        ry[i] = r.y();
+        rz[i] = r.z();
+    }
+
+    // hydrodynamic forces see the fluid where they act
+    float *density = m_forceDensities.data();
+
+    if (fluid->isUniform()) {
+        std::fill(density + m_bodyForcesEnd, density + count, float(fluid->density()));
+    } else {
+        for (int i = m_bodyForcesEnd; i < count; i++) {
+            QVector3D position = state.position + QVector3D(rx[i], ry[i], rz[i]);
+            density[i] = fluid->sample(position, time).density;
+        }
+    }
+
+    for (int i = 0; i < m_worldForcesEnd; i++) {
+        fx[i] = m_forceValues.x[i];
+        fy[i] = m_forceValues.y[i];
+        fz[i] = m_forceValues.z[i];
+    }
+
+    for (int i = m_worldForcesEnd; i < m_bodyForcesEnd; i++) {
+        btVector3 f = basis * btVector3(m_forceValues.x[i], m_forceValues.y[i], m_forceValues.z[i]);
+        fx[i] = f.x();
+        fy[i] = f.y();
+        fz[i] = f.z();
+    }
+
+    // drag opposes the velocity through the water with magnitude
+    // 1/2 rho A C v^2
+    const QVector3D &velocity = state.relativeVelocity;
+    const float speed = velocity.length();
+
+    for (int i = m_bodyForcesEnd, j = 0; i < m_dragForcesEnd; i++, j++) {
+        float k = -density[i] * m_dragCoefficients[j] * speed;
+        fx[i] = velocity.x() * k;
+        fy[i] = velocity.y() * k;
+        fz[i] = velocity.z() * k;
+    }
+
+    // lift is perpendicular to the velocity in the pitch and yaw planes with
+    // magnitude 1/2 rho A (alpha dCl/dalpha) v^2, and stalls past 15 degrees
+    const float stallAngle = qDegreesToRadians(15.);
+
+    float pitchSpeed = state.pitchVelocity.length();
+    float pitchAngleOfAttack = state.pitchAngleOfAttack;
+    float pitchFactor = 0;
+    if (qAbs(pitchAngleOfAttack) < stallAngle) {
+        pitchFactor = pitchAngleOfAttack * pitchSpeed;
+    }
+
+    float yawSpeed = state.yawVelocity.length();
+    float yawAngleOfAttack = state.yawAngleOfAttack;
+    float yawFactor = 0;
+    if (qAbs(yawAngleOfAttack) < stallAngle) {
+        yawFactor = yawAngleOfAttack * yawSpeed;
+    }
+
+    for (int i = m_dragForcesEnd, j = 0; i < count; i++, j++) {
+        float pitch = density[i] * m_liftPitchCoefficients[j] * pitchFactor;
+        float yaw = density[i] * m_liftYawCoefficients[j] * yawFactor;
+
+        fx[i] = -velocity.y() * pitch - velocity.z() * yaw;
+        fy[i] = velocity.x() * pitch;
+        fz[i] = velocity.x() * yaw;
+    }
+
+    btVector3 netForce(0, 0, 0);
+    btVector3 netTorque(0, 0, 0);
+
+    for (int i = 0; i < count; i++) {
+        btVector3 f(fx[i], fy[i], fz[i]);
+        btVector3 r(rx[i], ry[i], rz[i]);
+
+        netForce += f;
+        netTorque += r.cross(f);
+    }
+
+    m_netForce = QVector3D(netForce.x(), netForce.y(), netForce.z());
+    m_netTorque = QVector3D(netTorque.x(), netTorque.y(), netTorque.z());
+}
+
+void ForcePipeline::evaluateTorques(const Body *body, const Fluid *fluid, double time)
+{
+    const KinematicState &state = body->kinematics();
+    const QVector3D &angularVelocity = state.angularVelocity;
+
+    const int count = m_torques.size();
+
+    float *tx = m_torqueResults.x.data();
+    float *ty = m_torqueResults.y.data();
+    float *tz = m_torqueResults.z.data();
+
+    for (int i = 0; i < m_constantTorquesEnd; i++) {
+        tx[i] = m_torqueValues.x[i];
+        ty[i] = m_torqueValues.y[i];
+        tz[i] = m_torqueValues.z[i];
+    }
+
+    // quadratic drag against spinning in pitch (z) and yaw (y), in the
+    // fluid around the body
+    float bodyDensity = fluid->isUniform() ? fluid->density() : fluid->sample(state.position, time).density;
+
+    float pitchSpin = -bodyDensity * angularVelocity.z() * qAbs(angularVelocity.z());
+    float yawSpin = -bodyDensity * angularVelocity.y() * qAbs(angularVelocity.y());
+
+    for (int i = m_constantTorquesEnd, j = 0; i < m_spinningDragTorquesEnd; i++, j++) {
+        tx[i] = 0;
+        ty[i] = m_spinningDragYawCoefficients[j] * yawSpin;
+        tz[i] = m_spinningDragPitchCoefficients[j] * pitchSpin;
+    }
+
+    // fins damp rolling (x) quadratically, in the fluid around each fin
+    float rollSpin = -angularVelocity.x() * qAbs(angularVelocity.x());
+    const btMatrix3x3 &basis = body->body()->getCenterOfMassTransform().getBasis();
+
+    for (int i = m_spinningDragTorquesEnd, j = 0; i < count; i++, j++) {
+        float density = fluid->density();
+        if (!fluid->isUniform()) {
+            btVector3 r = basis * btVector3(m_dampingPositions.x[j], m_dampingPositions.y[j], m_dampingPositions.z[j]);
+            density = fluid->sample(state.position + QVector3D(r.x(), r.y(), r.z()), time).density;
+        }
+
+        tx[i] = density * m_dampingCoefficients[j] * rollSpin;
+        ty[i] = 0;
+        tz[i] = 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        m_netTorque += QVector3D(tx[i], ty[i], tz[i]);
+    }
+}
+
+void ForcePipeline::publish() const
+{
+    for (int i = 0; i < m_forces.size(); i++) {
+        Force *force = m_forces[i];
+
+        force->m_force = QVector3D(m_forceResults.x[i], m_forceResults.y[i], m_forceResults.z[i]);
+        force->m_localPosition = QVector3D(m_positionResults.x[i], m_positionResults.y[i], m_positionResults.z[i]);
+    }
+
+    for (int i = 0; i < m_torques.size(); i++) {
+        Torque *torque = m_torques[i];
+
+        torque->m_value = QVector3D(m_torqueResults.x[i], m_torqueResults.y[i], m_torqueResults.z[i]);
+    }
+}
+
+void ForcePipeline::saveResults(QDataStream &out) const
+{
+    out << m_forceResults.x << m_forceResults.y << m_forceResults.z;
+    out << m_positionResults.x << m_positionResults.y << m_positionResults.z;
+    out << m_torqueResults.x << m_torqueResults.y << m_torqueResults.z;
+    out << m_netForce << m_netTorque;
+}
+
+bool ForcePipeline::restoreResults(QDataStream &in)
+{
+    Vector3Array forceResults;
+    Vector3Array positionResults;
+    Vector3Array torqueResults;
+    QVector3D netForce;
+    QVector3D netTorque;
+
+    in >> forceResults.x >> forceResults.y >> forceResults.z;
+    in >> positionResults.x >> positionResults.y >> positionResults.z;
+    in >> torqueResults.x >> torqueResults.y >> torqueResults.z;
+    in >> netForce >> netTorque;
+
+    int forceCount = m_forces.size();
+    int torqueCount = m_torques.size();
+
+    if (in.status() != QDataStream::Ok ||
+            forceResults.x.size() != forceCount || forceResults.y.size() != forceCount ||
+            forceResults.z.size() != forceCount || positionResults.x.size() != forceCount ||
+            positionResults.y.size() != forceCount || positionResults.z.size() != forceCount ||
+            torqueResults.x.size() != torqueCount || torqueResults.y.size() != torqueCount ||
+            torqueResults.z.size() != torqueCount) {
+        return false;
+    }
+
+    m_forceResults = forceResults;
+    m_positionResults = positionResults;
+    m_torqueResults = torqueResults;
+    m_netForce = netForce;
+    m_netTorque = netTorque;
+
+    publish();
+
+    return true;
+}
+
+QVector3D ForcePipeline::netForce() const
+{
+    return m_netForce;
+}
+
+QVector3D ForcePipeline::netTorque() const
+{
+    return m_netTorque;
+}
@@ -0,0 +1,90 @@
+#ifndef FORCEPIPELINE_H
+#define FORCEPIPELINE_H
+
+#include <QVector3D>
+#include <QVector>
+
+class QDataStream;
+
+class Fluid;
+
+namespace Physics {
+
+class Body;
+class Force;
+class Torque;
+
+// Evaluates every force and torque on a body in one pass over contiguous
+// per-kind parameter arrays, and applies the net force and torque to Bullet
+// once. The Force and Torque objects it was compiled from only describe the
+// parameters and, after publish(), mirror the results for display.
+class ForcePipeline
+{
+public:
+    ForcePipeline();
+
+    void compile(const QVector<Force *> &forces, const QVector<Torque *> &torques);
+
+    void evaluate(const Body *body, const Fluid *fluid, double time);
+    void publish() const;
+
+    // the results of the last evaluation, so that a restored state shows
+    // the same forces as the one it was saved from
+    void saveResults(QDataStream &out) const;
+    bool restoreResults(QDataStream &in);
+
+    QVector3D netForce() const;
+    QVector3D netTorque() const;
+
+private:
+    struct Vector3Array
+    {
+        void clear();
+        void append(const QVector3D &v);
+        void resize(int size);
+
+        QVector<float> x;
+        QVector<float> y;
+        QVector<float> z;
+    };
+
+    void evaluateForces(const Body *body, const Fluid *fluid, double time);
+    void evaluateTorques(const Body *body, const Fluid *fluid, double time);
+
+    // forces, grouped by kind in this order
+    QVector<Force *> m_forces;
+    int m_worldForcesEnd;
+    int m_bodyForcesEnd;
+    int m_dragForcesEnd;
+
+    Vector3Array m_forcePositions;
+    Vector3Array m_forceValues;  // world and body forces
+    QVector<float> m_dragCoefficients;
+    QVector<float> m_liftPitchCoefficients;
+    QVector<float> m_liftYawCoefficients;
+
+    QVector<float> m_forceDensities;  // hydrodynamic forces
+
+    Vector3Array m_forceResults;
+    Vector3Array m_positionResults;
+
+    // torques, grouped by kind in this order
+    QVector<Torque *> m_torques;
+    int m_constantTorquesEnd;
+    int m_spinningDragTorquesEnd;
+
+    Vector3Array m_torqueValues;  // constant torques
+    QVector<float> m_spinningDragPitchCoefficients;
+    QVector<float> m_spinningDragYawCoefficients;
+    QVector<float> m_dampingCoefficients;
+    Vector3Array m_dampingPositions;
+
+    Vector3Array m_torqueResults;
+
+    QVector3D m_netForce;
+    QVector3D m_netTorque;
+};
+
+} // namespace Physics
+
+#endif // FORCEPIPELINE_H
@@ -1,10 +1,3 @@
-#include <QtDebug>
-#include <QtMath>
-
-#include <bullet/btBulletDynamicsCommon.h>
-
-#include "physics/body.h"
-
 #include "physics/torque.h"
 
 using namespace Physics;
@@ -17,21 +10,6 @@ Torque::Torque(QString name, QObject *parent) :
 
 }
 
-void Torque::apply()
-{
-    if (!m_body) {
-        qCritical() << "Body not set on torque:" << m_name;
-        return;
-    }
-
-    calculate();
-
-    btVector3 torque = btVector3(m_value.x(), m_value.y(), m_value.z());
-    m_body->body()->applyTorque(torque);
-
-    emit applied();
-}
-
 QString Torque::name() const
 {
     return m_name;
@@ -63,56 +41,17 @@ PropellorTorque::PropellorTorque(QObject *parent) :
 
 }
 
-void PropellorTorque::calculate()
-{
-    // intentionally do nothing
-}
-
 void PropellorTorque::setValue(const QVector3D &value)
 {
     m_value = value;
 }
 
-float calculateSpinningDrag(float fluidDensity, float area, float spinningDragCoefficient, float angularVelocity, float length)
-{
-    float v2 = angularVelocity * angularVelocity;
-    float value = (0.5f * fluidDensity * area * spinningDragCoefficient * v2) / length;
-
-    float drag = -value;
-    if (angularVelocity < 0) {
-        drag = value;
-    }
-
-    return drag;
-}
-
 SpinningDragTorque::SpinningDragTorque(QObject *parent) :
     Torque("Spinning Drag", parent)
 {
 
 }
 
-void SpinningDragTorque::calculate()
-{
-    float pitchAngularVelocity = m_body->angularVelocity().z();
-    float pitchDrag = calculateSpinningDrag(m_fluidDensity, m_pitchCrossSectionalArea, m_coefficient, pitchAngularVelocity, m_bodyLength);
-
-    float yawAngularVelocity = m_body->angularVelocity().y();
-    float yawDrag = calculateSpinningDrag(m_fluidDensity, m_yawCrossSectionalArea, m_coefficient, yawAngularVelocity, m_bodyLength);
-
-    m_value = QVector3D(0, yawDrag, pitchDrag);
-}
-
-double SpinningDragTorque::fluidDensity() const
-{
-    return m_fluidDensity;
-}
-
-void SpinningDragTorque::setFluidDensity(double fluidDensity)
-{
-    m_fluidDensity = fluidDensity;
-}
-
 double SpinningDragTorque::yawCrossSectionalArea() const
 {
     return m_yawCrossSectionalArea;
@@ -159,30 +98,6 @@ FinDampingTorque::FinDampingTorque(QObject *parent) :
 
 }
 
-void FinDampingTorque::calculate()
-{
-    float span = qSqrt(m_aspectRatio * m_crossSectionalArea);
-
-    float v2 = m_body->angularVelocity().x() * m_body->angularVelocity().x();
-    float torque = 2.f * m_fluidDensity * m_crossSectionalArea * v2 * (m_radius + span) * (m_radius + span) * (m_radius + span / 2.f);
-
-    if (m_body->angularVelocity().x() > 0) {
-        torque = -torque;
-    }
-
-    m_value = QVector3D(torque, 0, 0);
-}
-
-double FinDampingTorque::fluidDensity() const
-{
-    return m_fluidDensity;
-}
-
-void FinDampingTorque::setFluidDensity(double fluidDensity)
-{
-    m_fluidDensity = fluidDensity;
-}
-
 double FinDampingTorque::crossSectionalArea() const
 {
     return m_crossSectionalArea;
@@ -212,3 +127,13 @@ void FinDampingTorque::setRadius(double radius)
 {
     m_radius = radius;
 }
+
+QVector3D FinDampingTorque::position() const
+{
+    return m_position;
+}
+
+void FinDampingTorque::setPosition(const QVector3D &position)
+{
+    m_position = position;
+}
@@ -17,15 +17,6 @@ class Torque : public QObject
 public:
     explicit Torque(QString name, QObject *parent = 0);
 
-    void apply();
-
-protected:
-    virtual void calculate() = 0;
-
-signals:
-    void applied();
-
-public:
     QString name() const;
     void setName(const QString &name);
 
@@ -44,6 +35,8 @@ protected:
     Physics::Body *m_body;
 
     QVector3D m_value;
+
+    friend class ForcePipeline;
 };
 
 class PropellorTorque : public Torque
@@ -53,11 +46,9 @@ class PropellorTorque : public Torque
 public:
     explicit PropellorTorque(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
     void setValue(const QVector3D &value);
+
+    Q_PROPERTY(QVector3D value READ value WRITE setValue)
 };
 
 class SpinningDragTorque : public Torque
@@ -67,13 +58,6 @@ class SpinningDragTorque : public Torque
 public:
     explicit SpinningDragTorque(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
-    double fluidDensity() const;
-    void setFluidDensity(double fluidDensity);
-
     double yawCrossSectionalArea() const;
     void setYawCrossSectionalArea(double yawCrossSectionalArea);
 
@@ -86,8 +70,12 @@ public:
     double bodyLength() const;
     void setBodyLength(double bodyLength);
 
+    Q_PROPERTY(double yawCrossSectionalArea READ yawCrossSectionalArea WRITE setYawCrossSectionalArea)
+    Q_PROPERTY(double pitchCrossSectionalArea READ pitchCrossSectionalArea WRITE setPitchCrossSectionalArea)
+    Q_PROPERTY(double coefficient READ coefficient WRITE setCoefficient)
+    Q_PROPERTY(double bodyLength READ bodyLength WRITE setBodyLength)
+
 private:
-    double m_fluidDensity;
     double m_yawCrossSectionalArea;
     double m_pitchCrossSectionalArea;
     double m_coefficient;
@@ -101,13 +89,6 @@ class FinDampingTorque : public Torque
 public:
     explicit FinDampingTorque(QObject *parent = 0);
 
-protected:
-    void calculate();
-
-public:
-    double fluidDensity() const;
-    void setFluidDensity(double fluidDensity);
-
     double crossSectionalArea() const;
     void setCrossSectionalArea(double crossSectionalArea);
 
@@ -117,11 +98,19 @@ public:
     double radius() const;
     void setRadius(double radius);
 
+    QVector3D position() const;
+    void setPosition(const QVector3D &position);
+
+    Q_PROPERTY(double crossSectionalArea READ crossSectionalArea WRITE setCrossSectionalArea)
+    Q_PROPERTY(double aspectRatio READ aspectRatio WRITE setAspectRatio)
+    Q_PROPERTY(double radius READ radius WRITE setRadius)
+    Q_PROPERTY(QVector3D position READ position WRITE setPosition)
+
 private:
-    double m_fluidDensity;
     double m_crossSectionalArea;
     double m_aspectRatio;
     double m_radius;
+    QVector3D m_position;
 
 };
 
@@ -0,0 +1,150 @@
+#include <QMetaProperty>
+#include <QObject>
+#include <QStringList>
+#include <QVector3D>
+
+#include "propertypath.h"
+
+namespace {
+
+struct ResolvedPath
+{
+    QObject *object;
+    QString property;
+    int component;
+};
+
+int componentIndex(const QString &name)
+{
+    if (name == "x") {
+        return 0;
+    } else if (name == "y") {
+        return 1;
+    } else if (name == "z") {
+        return 2;
+    }
+
+    return -1;
+}
+
+void readProperties(const QObject *root, const QObject *object, PropertyValues *values)
+{
+    QString prefix = objectPath(root, object);
+    if (!prefix.isEmpty()) {
+        prefix += '.';
+    }
+
+    const QMetaObject *meta = object->metaObject();
+    for (int i = QObject::staticMetaObject.propertyCount(); i < meta->propertyCount(); i++) {
+        QMetaProperty property = meta->property(i);
+
+        if (!property.isWritable() || !property.isStored(object) ||
+                (QMetaType::typeFlags(property.userType()) & QMetaType::PointerToQObject)) {
+            continue;
+        }
+
+        values->append(qMakePair(prefix + property.name(), property.read(object)));
+    }
+
+    for (const QObject *child : object->children()) {
+        if (!child->objectName().isEmpty()) {
+            readProperties(root, child, values);
+        }
+    }
+}
+
+bool resolve(const QObject *root, const QString &path, ResolvedPath *resolved)
+{
+    QStringList segments = path.split('.');
+    QObject *object = const_cast<QObject *>(root);
+
+    int i = 0;
+    while (i < segments.size() - 1) {
+        QObject *child = object->findChild<QObject *>(segments[i], Qt::FindDirectChildrenOnly);
+        if (!child) {
+            break;
+        }
+
+        object = child;
+        i++;
+    }
+
+    resolved->object = object;
+    resolved->property = segments[i];
+    resolved->component = -1;
+
+    if (i == segments.size() - 2) {
+        resolved->component = componentIndex(segments[i + 1]);
+        if (resolved->component < 0) {
+            return false;
+        }
+    } else if (i != segments.size() - 1) {
+        return false;
+    }
+
+    return object->metaObject()->indexOfProperty(resolved->property.toLatin1().constData()) >= 0;
+}
+
+}
+
+QVariant readPropertyPath(const QObject *root, const QString &path, bool *ok)
+{
+    ResolvedPath resolved;
+    if (!resolve(root, path, &resolved)) {
+        if (ok) {
+            *ok = false;
+        }
+        return QVariant();
+    }
+
+    QVariant value = resolved.object->property(resolved.property.toLatin1().constData());
+
+    if (resolved.component >= 0) {
+        value = value.value<QVector3D>()[resolved.component];
+    }
+
+    if (ok) {
+        *ok = value.isValid();
+    }
+
+    return value;
+}
+
+bool writePropertyPath(QObject *root, const QString &path, const QVariant &value)
+{
+    ResolvedPath resolved;
+    if (!resolve(root, path, &resolved)) {
+        return false;
+    }
+
+    QByteArray name = resolved.property.toLatin1();
+
+    if (resolved.component < 0) {
+        return resolved.object->setProperty(name.constData(), value);
+    }
+
+    QVector3D vector = resolved.object->property(name.constData()).value<QVector3D>();
+    vector[resolved.component] = value.toFloat();
+
+    return resolved.object->setProperty(name.constData(), vector);
+}
+
+QString objectPath(const QObject *root, const QObject *object)
+{
+    QStringList segments;
+
+    while (object && object != root) {
+        segments.prepend(object->objectName());
+        object = object->parent();
+    }
+
+    return segments.join('.');
+}
+
+PropertyValues readProperties(const QObject *root)
+{
+    PropertyValues values;
+    readProperties(root, root, &values);
+
+    return values;
+}
@@ -0,0 +1,29 @@
+#ifndef PROPERTYPATH_H
+#define PROPERTYPATH_H
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVariant>
+
+class QObject;
+
+// Paths name a property relative to a root object, e.g. "fluid.density",
+// "submarine.drag.coefficient" or "submarine.thrust.value.x". Every segment
+// but the last names a direct child by its objectName; a trailing x, y or z
+// selects a component of a QVector3D property.
+
+QVariant readPropertyPath(const QObject *root, const QString &path, bool *ok = 0);
+bool writePropertyPath(QObject *root, const QString &path, const QVariant &value);
+
+// the path of object below root, e.g. "submarine.northFin.lift"
+QString objectPath(const QObject *root, const QObject *object);
+
+typedef QList<QPair<QString, QVariant> > PropertyValues;
+
+// every stored, writable property of root and its named descendants, each
+// object's own properties before its children's, so writing them back in
+// order reproduces the same state
+PropertyValues readProperties(const QObject *root);
+
+#endif // PROPERTYPATH_H
@@ -14416,6 +14416,358 @@ QCPData::QCPData(double key, double value) :
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPDataRing
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPDataRing
+  \brief A fixed-capacity ring buffer of data points for QCPGraph.
+  
+  Unlike \ref QCPDataMap, appending to a full ring overwrites the oldest point, so a graph that
+  only needs to show the most recent points can be fed indefinitely without any per-point
+  allocation. Keys and values are stored in two contiguous arrays; error bars are not supported.
+  
+  Points are expected to be appended in ascending key order, which allows the visible range to be
+  found with a binary search. If a point is appended with a smaller key than its predecessor, the
+  ring is marked as unsorted (see \ref isSorted) and QCPGraph falls back to drawing every point.
+  
+  Alongside the points, the ring maintains a pyramid of min/max envelopes: level k groups the
+  points into buckets of 4^(k+1) consecutive points and keeps the key span and value extremes of
+  each bucket. The pyramid is updated incrementally by \ref append, in constant time per level.
+  \ref getEnvelope uses it to summarize any index range with a number of points proportional to
+  the requested resolution rather than to the length of the range, which is what keeps drawing a
+  graph with millions of points proportional to its width in pixels.
+  
+  \see QCPGraph::setDataCapacity
+*/
+
+/*!
+  Constructs a ring that holds up to \a capacity data points.
+*/
+QCPDataRing::QCPDataRing(int capacity) :
+  mBegin(0),
+  mSize(0),
+  mSorted(true),
+  mCount(0)
+{
+  setCapacity(capacity);
+}
+
+/*!
+  Changes the number of data points the ring can hold. If the ring currently holds more than \a
+  capacity points, only the most recent ones are kept.
+*/
+void QCPDataRing::setCapacity(int capacity)
+{
+  capacity = qMax(0, capacity);
+  if (capacity == mKeys.size())
+    return;
+  
+  int keep = qMin(mSize, capacity);
+  QVector<double> keys(capacity), values(capacity);
+  for (int i=0; i<keep; ++i)
+  {
+    keys[i] = key(mSize-keep+i);
+    values[i] = value(mSize-keep+i);
+  }
+  mKeys.swap(keys);
+  mValues.swap(values);
+  mBegin = 0;
+  mSize = keep;
+  rebuildLevels();
+}
+
+/*!
+  Appends the data point \a key, \a value. If the ring is full, the oldest data point is dropped.
+*/
+void QCPDataRing::append(double key, double value)
+{
+  int capacity = mKeys.size();
+  if (capacity == 0)
+    return;
+  
+  if (mSize > 0 && key < this->key(mSize-1))
+    mSorted = false;
+  
+  int i;
+  if (mSize < capacity)
+  {
+    i = physicalIndex(mSize);
+    ++mSize;
+  } else
+  {
+    i = mBegin;
+    mBegin = (mBegin+1 < capacity ? mBegin+1 : 0);
+  }
+  mKeys[i] = key;
+  mValues[i] = value;
+  appendToLevels(key, value);
+}
+
+/*!
+  Removes all data points without releasing the storage.
+*/
+void QCPDataRing::clear()
+{
+  mBegin = 0;
+  mSize = 0;
+  mSorted = true;
+  mCount = 0;
+  for (int k=0; k<mLevels.size(); ++k)
+  {
+    mLevels[k].begin = 0;
+    mLevels[k].size = 0;
+  }
+}
+
+/*!
+  Returns the index of the first data point whose key is not smaller than \a key, or \ref size if
+  there is none. Only meaningful if the ring \ref isSorted.
+*/
+int QCPDataRing::lowerBound(double key) const
+{
+  int lower = 0, upper = mSize;
+  while (lower < upper)
+  {
+    int middle = lower+(upper-lower)/2;
+    if (this->key(middle) < key)
+      lower = middle+1;
+    else
+      upper = middle;
+  }
+  return lower;
+}
+
+/*!
+  Returns the index of the first data point whose key is greater than \a key, or \ref size if
+  there is none. Only meaningful if the ring \ref isSorted.
+*/
+int QCPDataRing::upperBound(double key) const
+{
+  int lower = 0, upper = mSize;
+  while (lower < upper)
+  {
+    int middle = lower+(upper-lower)/2;
+    if (this->key(middle) <= key)
+      lower = middle+1;
+    else
+      upper = middle;
+  }
+  return lower;
+}
+
+/*!
+  Returns the range spanned by the keys in the ring, restricted to \a inSignDomain. \a foundRange
+  is set to whether there was any key to span.
+*/
+QCPRange QCPDataRing::keyRange(bool &foundRange, QCPAbstractPlottable::SignDomain inSignDomain) const
+{
+  QCPRange range;
+  foundRange = false;
+  if (mSorted && inSignDomain == QCPAbstractPlottable::sdBoth) // keys are ascending, so the ends are the extremes
+  {
+    if (mSize > 0)
+    {
+      range.lower = key(0);
+      range.upper = key(mSize-1);
+      foundRange = true;
+    }
+    return range;
+  }
+  
+  for (int i=0; i<mSize; ++i)
+  {
+    double current = key(i);
+    if ((inSignDomain == QCPAbstractPlottable::sdNegative && current >= 0) ||
+        (inSignDomain == QCPAbstractPlottable::sdPositive && current <= 0))
+      continue;
+    if (current < range.lower || !foundRange)
+      range.lower = current;
+    if (current > range.upper || !foundRange)
+      range.upper = current;
+    foundRange = true;
+  }
+  return range;
+}
+
+/*!
+  Returns the range spanned by the values in the ring, restricted to \a inSignDomain. \a
+  foundRange is set to whether there was any value to span. NaN values are ignored.
+*/
+QCPRange QCPDataRing::valueRange(bool &foundRange, QCPAbstractPlottable::SignDomain inSignDomain) const
+{
+  QCPRange range;
+  foundRange = false;
+  if (inSignDomain == QCPAbstractPlottable::sdBoth && !mLevels.isEmpty()) // the envelope holds the same extremes in about 3*sqrt(size) points
+  {
+    QVector<QCPData> envelope;
+    getEnvelope(0, mSize-1, int(qSqrt(mSize)), &envelope);
+    for (int i=0; i<envelope.size(); ++i)
+    {
+      double current = envelope.at(i).value;
+      if (qIsNaN(current))
+        continue;
+      if (current < range.lower || !foundRange)
+        range.lower = current;
+      if (current > range.upper || !foundRange)
+        range.upper = current;
+      foundRange = true;
+    }
+    return range;
+  }
+  
+  for (int i=0; i<mSize; ++i)
+  {
+    double current = value(i);
+    if (qIsNaN(current) ||
+        (inSignDomain == QCPAbstractPlottable::sdNegative && current >= 0) ||
+        (inSignDomain == QCPAbstractPlottable::sdPositive && current <= 0))
+      continue;
+    if (current < range.lower || !foundRange)
+      range.lower = current;
+    if (current > range.upper || !foundRange)
+      range.upper = current;
+    foundRange = true;
+  }
+  return range;
+}
+
+/*!
+  Appends a summary of the data points from index \a lower to \a upper (inclusive) to \a data.
+  
+  The summary is read from the coarsest envelope level whose buckets hold at most \a maxBucketSize
+  points. Every whole bucket in the range contributes two points, its minimum at its lowest key
+  and its maximum at its highest key, while points in partially covered buckets at either end are
+  copied as they are. If no level is fine enough, all points are copied.
+  
+  The result therefore spans the same keys and the same value extremes as the original points,
+  using roughly 2*(upper-lower+1)/maxBucketSize points.
+*/
+void QCPDataRing::getEnvelope(int lower, int upper, int maxBucketSize, QVector<QCPData> *data) const
+{
+  lower = qMax(0, lower);
+  upper = qMin(mSize-1, upper);
+  if (lower > upper)
+    return;
+  
+  int levelIndex = -1;
+  for (int k=0; k<mLevels.size(); ++k)
+  {
+    if (mLevels.at(k).bucketSize <= maxBucketSize)
+      levelIndex = k;
+  }
+  
+  // points are addressed by the absolute count since the last clear, which is what buckets are aligned to:
+  qint64 base = mCount-mSize;
+  qint64 first = base+lower;
+  qint64 last = base+upper;
+  qint64 bucketSize = levelIndex < 0 ? 1 : mLevels.at(levelIndex).bucketSize;
+  qint64 wholeBegin = (first+bucketSize-1)/bucketSize*bucketSize;
+  qint64 wholeEnd = (last+1)/bucketSize*bucketSize;
+  
+  if (levelIndex < 0 || wholeBegin >= wholeEnd)
+  {
+    data->reserve(data->size()+upper-lower+1);
+    for (int i=lower; i<=upper; ++i)
+      data->append(at(i));
+    return;
+  }
+  
+  const Level &level = mLevels.at(levelIndex);
+  data->reserve(data->size()+int(wholeBegin-first)+2*int((wholeEnd-wholeBegin)/bucketSize)+int(last+1-wholeEnd));
+  
+  for (qint64 i=first; i<wholeBegin; ++i)
+    data->append(at(int(i-base)));
+  
+  qint64 lastBucket = (mCount-1)/bucketSize;
+  for (qint64 n=wholeBegin/bucketSize; n<wholeEnd/bucketSize; ++n)
+  {
+    int i = level.begin+level.size-1-int(lastBucket-n);
+    if (i >= level.buckets.size())
+      i -= level.buckets.size();
+    const Envelope &envelope = level.buckets.at(i);
+    data->append(QCPData(envelope.lowerKey, envelope.minValue));
+    data->append(QCPData(envelope.upperKey, envelope.maxValue));
+  }
+  
+  for (qint64 i=wholeEnd; i<=last; ++i)
+    data->append(at(int(i-base)));
+}
+
+/*! \internal
+  
+  Sizes the envelope levels for the current capacity and fills them from the points currently in
+  the ring.
+*/
+void QCPDataRing::rebuildLevels()
+{
+  mLevels.clear();
+  int capacity = mKeys.size();
+  for (qint64 bucketSize=4; bucketSize<capacity; bucketSize*=4)
+  {
+    Level level;
+    level.bucketSize = bucketSize;
+    level.buckets.resize(capacity/bucketSize+2); // +2 for the partially covered buckets at either end
+    level.begin = 0;
+    level.size = 0;
+    mLevels.append(level);
+  }
+  
+  mCount = 0;
+  for (int i=0; i<mSize; ++i)
+    appendToLevels(key(i), value(i));
+}
+
+/*! \internal
+  
+  Adds the point \a key, \a value to the last bucket of every envelope level, starting a new bucket
+  (and dropping the oldest one if the level is full) where the point begins one.
+*/
+void QCPDataRing::appendToLevels(double key, double value)
+{
+  for (int k=0; k<mLevels.size(); ++k)
+  {
+    Level &level = mLevels[k];
+    int capacity = level.buckets.size();
+    if (mCount % level.bucketSize == 0) // point starts a new bucket
+    {
+      int i;
+      if (level.size < capacity)
+      {
+        i = level.begin+level.size;
+        if (i >= capacity)
+          i -= capacity;
+        ++level.size;
+      } else
+      {
+        i = level.begin;
+        level.begin = (level.begin+1 < capacity ? level.begin+1 : 0);
+      }
+      Envelope &envelope = level.buckets[i];
+      envelope.lowerKey = key;
+      envelope.upperKey = key;
+      envelope.minValue = value;
+      envelope.maxValue = value;
+    } else
+    {
+      int i = level.begin+level.size-1;
+      if (i >= capacity)
+        i -= capacity;
+      Envelope &envelope = level.buckets[i];
+      envelope.upperKey = key;
+      if (!qIsNaN(value))
+      {
+        if (value < envelope.minValue || qIsNaN(envelope.minValue))
+          envelope.minValue = value;
+        if (value > envelope.maxValue || qIsNaN(envelope.maxValue))
+          envelope.maxValue = value;
+      }
+    }
+  }
+  ++mCount;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// QCPGraph
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -14481,7 +14833,8 @@ QCPData::QCPData(double key, double value) :
   To directly create a graph inside a plot, you can also use the simpler QCustomPlot::addGraph function.
 */
 QCPGraph::QCPGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
-  QCPAbstractPlottable(keyAxis, valueAxis)
+  QCPAbstractPlottable(keyAxis, valueAxis),
+  mDataRing(0)
 {
   mData = new QCPDataMap;
   
@@ -14502,6 +14855,7 @@ QCPGraph::QCPGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
 QCPGraph::~QCPGraph()
 {
   delete mData;
+  delete mDataRing;
 }
 
 /*!
@@ -14851,6 +15205,36 @@ void QCPGraph::setAdaptiveSampling(bool enabled)
   mAdaptiveSampling = enabled;
 }
 
+/*!
+  Switches the graph to keep its data in a \ref QCPDataRing holding at most \a capacity points.
+  Once the ring is full, every added point replaces the oldest one, without any allocation. This
+  suits graphs that show a sliding window over a live data source.
+  
+  While the ring is in use, \ref addData(double key, double value), \ref addData(const QCPData
+  &data), \ref addData(const QVector<double> &keys, const QVector<double> &values) and \ref
+  clearData operate on the ring and the \ref QCPDataMap returned by \ref data is ignored. Error
+  bars are not drawn for ring data.
+  
+  Passing a \a capacity of 0 switches back to the \ref QCPDataMap. Changing the capacity keeps
+  the most recent points.
+  
+  \see dataRing
+*/
+void QCPGraph::setDataCapacity(int capacity)
+{
+  if (capacity <= 0)
+  {
+    delete mDataRing;
+    mDataRing = 0;
+  } else if (mDataRing)
+  {
+    mDataRing->setCapacity(capacity);
+  } else
+  {
+    mDataRing = new QCPDataRing(capacity);
+  }
+}
+
 /*!
   Adds the provided data points in \a dataMap to the current data.
   
@@ -14874,6 +15258,11 @@ void QCPGraph::addData(const QCPDataMap &dataMap)
 */
 void QCPGraph::addData(const QCPData &data)
 {
+  if (mDataRing)
+  {
+    mDataRing->append(data.key, data.value);
+    return;
+  }
   mData->insertMulti(data.key, data);
 }
 
@@ -14887,6 +15276,11 @@ void QCPGraph::addData(const QCPData &data)
 */
 void QCPGraph::addData(double key, double value)
 {
+  if (mDataRing)
+  {
+    mDataRing->append(key, value);
+    return;
+  }
   QCPData newData;
   newData.key = key;
   newData.value = value;
@@ -14904,6 +15298,12 @@ void QCPGraph::addData(double key, double value)
 void QCPGraph::addData(const QVector<double> &keys, const QVector<double> &values)
 {
   int n = qMin(keys.size(), values.size());
+  if (mDataRing)
+  {
+    for (int i=0; i<n; ++i)
+      mDataRing->append(keys[i], values[i]);
+    return;
+  }
   QCPData newData;
   for (int i=0; i<n; ++i)
   {
@@ -14972,13 +15372,15 @@ void QCPGraph::removeData(double key)
 void QCPGraph::clearData()
 {
   mData->clear();
+  if (mDataRing)
+    mDataRing->clear();
 }
 
 /* inherits documentation from base class */
 double QCPGraph::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
 {
   Q_UNUSED(details)
-  if ((onlySelectable && !mSelectable) || mData->isEmpty())
+  if ((onlySelectable && !mSelectable) || isDataEmpty())
     return -1;
   if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return -1; }
   
@@ -15012,7 +15414,7 @@ void QCPGraph::rescaleKeyAxis(bool onlyEnlarge, bool includeErrorBars) const
 {
   // this code is a copy of QCPAbstractPlottable::rescaleKeyAxis with the only change
   // that getKeyRange is passed the includeErrorBars value.
-  if (mData->isEmpty()) return;
+  if (isDataEmpty()) return;
   
   QCPAxis *keyAxis = mKeyAxis.data();
   if (!keyAxis) { qDebug() << Q_FUNC_INFO << "invalid key axis"; return; }
@@ -15048,7 +15450,7 @@ void QCPGraph::rescaleValueAxis(bool onlyEnlarge, bool includeErrorBars) const
 {
   // this code is a copy of QCPAbstractPlottable::rescaleValueAxis with the only change
   // is that getValueRange is passed the includeErrorBars value.
-  if (mData->isEmpty()) return;
+  if (isDataEmpty()) return;
   
   QCPAxis *valueAxis = mValueAxis.data();
   if (!valueAxis) { qDebug() << Q_FUNC_INFO << "invalid value axis"; return; }
@@ -15077,7 +15479,7 @@ void QCPGraph::rescaleValueAxis(bool onlyEnlarge, bool includeErrorBars) const
 void QCPGraph::draw(QCPPainter *painter)
 {
   if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
-  if (mKeyAxis.data()->range().size() <= 0 || mData->isEmpty()) return;
+  if (mKeyAxis.data()->range().size() <= 0 || isDataEmpty()) return;
   if (mLineStyle == lsNone && mScatterStyle.isNone()) return;
   
   // allocate line and (if necessary) point vectors:
@@ -15663,6 +16065,11 @@ void QCPGraph::getPreparedData(QVector<QCPData> *lineData, QVector<QCPData> *sca
   QCPAxis *keyAxis = mKeyAxis.data();
   QCPAxis *valueAxis = mValueAxis.data();
   if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  if (mDataRing)
+  {
+    getPreparedRingData(lineData, scatterData);
+    return;
+  }
   // get visible data range:
   QCPDataMap::const_iterator lower, upper; // note that upper is the actual upper point, and not 1 step after the upper point
   getVisibleDataBounds(lower, upper);
@@ -15839,6 +16246,131 @@ void QCPGraph::getPreparedData(QVector<QCPData> *lineData, QVector<QCPData> *sca
   }
 }
 
+/*! \internal
+  
+  The counterpart of \ref getPreparedData for graphs whose data is kept in a \ref QCPDataRing (see
+  \ref setDataCapacity). The visible range is found with a binary search and the points are read
+  straight from the ring's arrays, so no map iteration is involved.
+  
+  With adaptive sampling, line data is read through the ring's min/max envelope (see \ref
+  QCPDataRing::getEnvelope) and reduced to the same per-pixel clusters as in \ref getPreparedData,
+  so its cost is proportional to the plot's width. Scatter data is thinned to roughly two points
+  per pixel. If the ring is
+  not sorted by key, all points are passed on one-to-one.
+*/
+void QCPGraph::getPreparedRingData(QVector<QCPData> *lineData, QVector<QCPData> *scatterData) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  const QCPDataRing *ring = mDataRing;
+  if (ring->isEmpty())
+    return;
+  
+  // get visible index range, including one point beyond each end of the axis range (like getVisibleDataBounds):
+  int lower = 0;
+  int upper = ring->size()-1;
+  if (ring->isSorted())
+  {
+    lower = qMax(0, ring->lowerBound(keyAxis->range().lower)-1);
+    upper = qMin(ring->size()-1, ring->upperBound(keyAxis->range().upper));
+  }
+  int dataCount = upper-lower+1;
+  
+  int maxCount = std::numeric_limits<int>::max();
+  if (mAdaptiveSampling && ring->isSorted())
+  {
+    int keyPixelSpan = qAbs(keyAxis->coordToPixel(ring->key(lower))-keyAxis->coordToPixel(ring->key(upper)));
+    maxCount = 2*keyPixelSpan+2;
+  }
+  
+  if (dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  {
+    if (lineData)
+    {
+      // read the visible range through the ring's min/max envelope at about one bucket per pixel,
+      // so that the work below depends on the width of the plot rather than the number of points:
+      QVector<QCPData> points;
+      ring->getEnvelope(lower, upper, qMax(1, 2*dataCount/maxCount), &points);
+      
+      int reversedFactor = keyAxis->rangeReversed() != (keyAxis->orientation()==Qt::Vertical) ? -1 : 1; // is used to calculate keyEpsilon pixel into the correct direction
+      int reversedRound = keyAxis->rangeReversed() != (keyAxis->orientation()==Qt::Vertical) ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+      double minValue = points.first().value;
+      double maxValue = minValue;
+      int currentIntervalFirstPoint = 0;
+      double currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(points.first().key)+reversedRound));
+      double lastIntervalEndKey = currentIntervalStartKey;
+      double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
+      bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
+      int intervalDataCount = 1;
+      lineData->reserve(2*maxCount+2); // +2 for possible fill end points
+      for (int i=1; i<points.size(); ++i)
+      {
+        double key = points.at(i).key;
+        double value = points.at(i).value;
+        if (key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this cluster if necessary
+        {
+          if (value < minValue)
+            minValue = value;
+          else if (value > maxValue)
+            maxValue = value;
+          ++intervalDataCount;
+        } else // new pixel interval started
+        {
+          if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+          {
+            if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
+              lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.2, points.at(currentIntervalFirstPoint).value));
+            lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+            lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+            if (key > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
+              lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.8, points.at(i-1).value));
+          } else
+            lineData->append(points.at(currentIntervalFirstPoint));
+          lastIntervalEndKey = points.at(i-1).key;
+          minValue = value;
+          maxValue = value;
+          currentIntervalFirstPoint = i;
+          currentIntervalStartKey = keyAxis->pixelToCoord((int)(keyAxis->coordToPixel(key)+reversedRound));
+          if (keyEpsilonVariable)
+            keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+          intervalDataCount = 1;
+        }
+      }
+      // handle last interval:
+      if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+      {
+        if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
+          lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.2, points.at(currentIntervalFirstPoint).value));
+        lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+        lineData->append(QCPData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+      } else
+        lineData->append(points.at(currentIntervalFirstPoint));
+    }
+    
+    if (scatterData)
+    {
+      int stride = dataCount/maxCount+1;
+      scatterData->reserve(dataCount/stride+1);
+      for (int i=lower; i<=upper; i+=stride)
+        scatterData->append(ring->at(i));
+    }
+  } else // don't use adaptive sampling algorithm, transfer points one-to-one from the ring into the output parameters
+  {
+    QVector<QCPData> *dataVector = 0;
+    if (lineData)
+      dataVector = lineData;
+    else if (scatterData)
+      dataVector = scatterData;
+    if (dataVector)
+    {
+      dataVector->reserve(dataCount+2); // +2 for possible fill end points
+      for (int i=lower; i<=upper; ++i)
+        dataVector->append(ring->at(i));
+    }
+    if (lineData && scatterData)
+      *scatterData = *dataVector;
+  }
+}
+
 /*!  \internal
   
   called by the scatter drawing function (\ref drawScatterPlot) to draw the error bars on one data
@@ -16399,7 +16931,7 @@ int QCPGraph::findIndexAboveY(const QVector<QPointF> *data, double y) const
 */
 double QCPGraph::pointDistance(const QPointF &pixelPoint) const
 {
-  if (mData->isEmpty())
+  if (isDataEmpty())
     return -1.0;
   if (mLineStyle == lsNone && mScatterStyle.isNone())
     return -1.0;
@@ -16505,6 +17037,9 @@ QCPRange QCPGraph::getValueRange(bool &foundRange, SignDomain inSignDomain) cons
 */
 QCPRange QCPGraph::getKeyRange(bool &foundRange, SignDomain inSignDomain, bool includeErrors) const
 {
+  if (mDataRing)
+    return mDataRing->keyRange(foundRange, inSignDomain);
+  
   QCPRange range;
   bool haveLower = false;
   bool haveUpper = false;
@@ -16620,6 +17155,9 @@ QCPRange QCPGraph::getKeyRange(bool &foundRange, SignDomain inSignDomain, bool i
 */
 QCPRange QCPGraph::getValueRange(bool &foundRange, SignDomain inSignDomain, bool includeErrors) const
 {
+  if (mDataRing)
+    return mDataRing->valueRange(foundRange, inSignDomain);
+  
   QCPRange range;
   bool haveLower = false;
   bool haveUpper = false;
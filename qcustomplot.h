@@ -2487,6 +2487,57 @@ typedef QMapIterator<double, QCPData> QCPDataMapIterator;
 typedef QMutableMapIterator<double, QCPData> QCPDataMutableMapIterator;
 
 
+class QCP_LIB_DECL QCPDataRing
+{
+public:
+  explicit QCPDataRing(int capacity=0);
+  
+  // getters:
+  int capacity() const { return mKeys.size(); }
+  int size() const { return mSize; }
+  bool isEmpty() const { return mSize == 0; }
+  bool isSorted() const { return mSorted; }
+  double key(int index) const { return mKeys.at(physicalIndex(index)); }
+  double value(int index) const { return mValues.at(physicalIndex(index)); }
+  QCPData at(int index) const { return QCPData(key(index), value(index)); }
+  
+  // setters:
+  void setCapacity(int capacity);
+  
+  // non-property methods:
+  void append(double key, double value);
+  void clear();
+  int lowerBound(double key) const;
+  int upperBound(double key) const;
+  QCPRange keyRange(bool &foundRange, QCPAbstractPlottable::SignDomain inSignDomain) const;
+  QCPRange valueRange(bool &foundRange, QCPAbstractPlottable::SignDomain inSignDomain) const;
+  void getEnvelope(int lower, int upper, int maxBucketSize, QVector<QCPData> *data) const;
+  
+protected:
+  struct Envelope
+  {
+    double lowerKey, upperKey;
+    double minValue, maxValue;
+  };
+  struct Level
+  {
+    int bucketSize;
+    QVector<Envelope> buckets;
+    int begin, size;
+  };
+  
+  QVector<double> mKeys, mValues;
+  int mBegin, mSize;
+  bool mSorted;
+  QVector<Level> mLevels;
+  qint64 mCount;
+  
+  int physicalIndex(int index) const { int i = mBegin+index; return i < mKeys.size() ? i : i-mKeys.size(); }
+  void rebuildLevels();
+  void appendToLevels(double key, double value);
+};
+
+
 class QCP_LIB_DECL QCPGraph : public QCPAbstractPlottable
 {
   Q_OBJECT
@@ -2530,6 +2581,7 @@ public:
   
   // getters:
   QCPDataMap *data() const { return mData; }
+  QCPDataRing *dataRing() const { return mDataRing; }
   LineStyle lineStyle() const { return mLineStyle; }
   QCPScatterStyle scatterStyle() const { return mScatterStyle; }
   ErrorType errorType() const { return mErrorType; }
@@ -2556,6 +2608,7 @@ public:
   void setErrorBarSkipSymbol(bool enabled);
   void setChannelFillGraph(QCPGraph *targetGraph);
   void setAdaptiveSampling(bool enabled);
+  void setDataCapacity(int capacity);
   
   // non-property methods:
   void addData(const QCPDataMap &dataMap);
@@ -2580,6 +2633,7 @@ public:
 protected:
   // property members:
   QCPDataMap *mData;
+  QCPDataRing *mDataRing;
   QPen mErrorPen;
   LineStyle mLineStyle;
   QCPScatterStyle mScatterStyle;
@@ -2605,6 +2659,8 @@ protected:
   
   // non-virtual methods:
   void getPreparedData(QVector<QCPData> *lineData, QVector<QCPData> *scatterData) const;
+  void getPreparedRingData(QVector<QCPData> *lineData, QVector<QCPData> *scatterData) const;
+  bool isDataEmpty() const { return mDataRing ? mDataRing->isEmpty() : mData->isEmpty(); }
   void getPlotData(QVector<QPointF> *lineData, QVector<QCPData> *scatterData) const;
   void getScatterPlotData(QVector<QCPData> *scatterData) const;
   void getLinePlotData(QVector<QPointF> *linePixelData, QVector<QCPData> *scatterData) const;
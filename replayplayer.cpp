@@ -0,0 +1,235 @@
+#include <QQuaternion>
+#include <QVector3D>
+
+#include "physics/force.h"
+#include "physics/torque.h"
+#include "propertypath.h"
+#include "simulationsnapshot.h"
+#include "submarine.h"
+
+#include "replayplayer.h"
+
+ReplayPlayer::ReplayPlayer(QObject *parent) :
+    QObject(parent),
+    m_time(0),
+    m_speed(1),
+    m_playing(false)
+{
+
+}
+
+bool ReplayPlayer::open(const QString &fileName, const Submarine *submarine)
+{
+    close();
+
+    if (!m_file.open(fileName)) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    if (m_file.rowCount() == 0 || m_file.columnNames().value(0) != "time") {
+        m_errorString = "The file holds no recorded steps";
+        m_file.close();
+        return false;
+    }
+
+    m_position = vectorColumns("x", "y", "z");
+    m_rotationScalar = m_file.indexOf("qw");
+    m_rotationVector = vectorColumns("qx", "qy", "qz");
+    m_linearVelocity = vectorColumns("vx", "vy", "vz");
+    m_angularVelocity = vectorColumns("wx", "wy", "wz");
+
+    m_roll = m_file.indexOf("roll");
+    m_yaw = m_file.indexOf("yaw");
+    m_pitch = m_file.indexOf("pitch");
+
+    m_rollAngleOfAttack = m_file.indexOf("rollAngleOfAttack");
+    m_yawAngleOfAttack = m_file.indexOf("yawAngleOfAttack");
+    m_pitchAngleOfAttack = m_file.indexOf("pitchAngleOfAttack");
+
+    // forces are matched by name rather than position, so a file recorded
+    // with a different set of forces still shows the ones in common
+    for (const Physics::Force *force : submarine->forces()) {
+        QString path = objectPath(submarine, force);
+        m_forces.append(vectorColumns(path + ".force.x", path + ".force.y", path + ".force.z"));
+        m_forcePositions.append(vectorColumns(path + ".worldPosition.x", path + ".worldPosition.y",
+                                              path + ".worldPosition.z"));
+    }
+
+    for (const Physics::Torque *torque : submarine->torques()) {
+        QString path = objectPath(submarine, torque);
+        m_torques.append(vectorColumns(path + ".value.x", path + ".value.y", path + ".value.z"));
+    }
+
+    m_time = m_file.startTime();
+
+    return true;
+}
+
+void ReplayPlayer::close()
+{
+    m_file.close();
+
+    m_forces.clear();
+    m_forcePositions.clear();
+    m_torques.clear();
+
+    m_time = 0;
+    m_playing = false;
+}
+
+bool ReplayPlayer::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+void ReplayPlayer::advance(double seconds)
+{
+    if (!m_playing) {
+        return;
+    }
+
+    setTime(m_time + seconds * m_speed);
+
+    if ((m_speed > 0 && m_time >= endTime()) || (m_speed < 0 && m_time <= startTime())) {
+        m_playing = false;
+    }
+}
+
+void ReplayPlayer::step()
+{
+    qint64 row = m_file.rowAt(m_time);
+    if (row + 1 < m_file.rowCount()) {
+        setTime(m_file.value(row + 1, 0));
+    }
+}
+
+void ReplayPlayer::takeSnapshot(SimulationSnapshot *snapshot) const
+{
+    qint64 row = m_file.rowAt(m_time);
+    qint64 next = qMin(row + 1, m_file.rowCount() - 1);
+
+    double rowTime = m_file.value(row, 0);
+    double nextTime = m_file.value(next, 0);
+
+    double alpha = 0;
+    if (nextTime > rowTime) {
+        alpha = qBound(0., (m_time - rowTime) / (nextTime - rowTime), 1.);
+    }
+
+    QVector3D rowPosition = vector(row, m_position);
+    QQuaternion rowRotation(scalar(row, m_rotationScalar), vector(row, m_rotationVector));
+
+    QVector3D nextPosition = vector(next, m_position);
+    QQuaternion nextRotation(scalar(next, m_rotationScalar), vector(next, m_rotationVector));
+
+    // the pose is interpolated here, so there is nothing left for the
+    // caller to interpolate between
+    snapshot->frame = row;
+    snapshot->time = m_time;
+    snapshot->timeStep = nextTime - rowTime;
+
+    snapshot->position = rowPosition + (nextPosition - rowPosition) * alpha;
+    snapshot->rotation = QQuaternion::slerp(rowRotation, nextRotation, alpha);
+
+    snapshot->previousPosition = snapshot->position;
+    snapshot->previousRotation = snapshot->rotation;
+
+    snapshot->linearVelocity = vector(row, m_linearVelocity);
+    snapshot->angularVelocity = vector(row, m_angularVelocity);
+
+    snapshot->roll = scalar(row, m_roll);
+    snapshot->yaw = scalar(row, m_yaw);
+    snapshot->pitch = scalar(row, m_pitch);
+
+    snapshot->rollAngleOfAttack = scalar(row, m_rollAngleOfAttack);
+    snapshot->yawAngleOfAttack = scalar(row, m_yawAngleOfAttack);
+    snapshot->pitchAngleOfAttack = scalar(row, m_pitchAngleOfAttack);
+
+    snapshot->forces.resize(m_forces.size());
+    for (int i = 0; i < m_forces.size(); i++) {
+        snapshot->forces[i].value = vector(row, m_forces[i]);
+        snapshot->forces[i].position = vector(row, m_forcePositions[i]);
+    }
+
+    snapshot->torques.resize(m_torques.size());
+    for (int i = 0; i < m_torques.size(); i++) {
+        snapshot->torques[i].value = vector(row, m_torques[i]);
+        snapshot->torques[i].position = snapshot->position;
+    }
+}
+
+QString ReplayPlayer::fileName() const
+{
+    return m_file.fileName();
+}
+
+QString ReplayPlayer::errorString() const
+{
+    return m_errorString;
+}
+
+double ReplayPlayer::time() const
+{
+    return m_time;
+}
+
+void ReplayPlayer::setTime(double time)
+{
+    m_time = qBound(startTime(), time, endTime());
+}
+
+double ReplayPlayer::speed() const
+{
+    return m_speed;
+}
+
+void ReplayPlayer::setSpeed(double speed)
+{
+    m_speed = speed;
+}
+
+bool ReplayPlayer::isPlaying() const
+{
+    return m_playing;
+}
+
+void ReplayPlayer::setPlaying(bool playing)
+{
+    m_playing = playing && isOpen();
+
+    // playing from the end starts over
+    if (m_playing && m_speed > 0 && m_time >= endTime()) {
+        m_time = startTime();
+    }
+}
+
+double ReplayPlayer::startTime() const
+{
+    return m_file.startTime();
+}
+
+double ReplayPlayer::endTime() const
+{
+    return m_file.endTime();
+}
+
+ReplayPlayer::VectorColumns ReplayPlayer::vectorColumns(const QString &x, const QString &y, const QString &z) const
+{
+    VectorColumns columns;
+    columns.x = m_file.indexOf(x);
+    columns.y = m_file.indexOf(y);
+    columns.z = m_file.indexOf(z);
+
+    return columns;
+}
+
+QVector3D ReplayPlayer::vector(qint64 row, const VectorColumns &columns) const
+{
+    return QVector3D(scalar(row, columns.x), scalar(row, columns.y), scalar(row, columns.z));
+}
+
+double ReplayPlayer::scalar(qint64 row, int column) const
+{
+    return column >= 0 ? m_file.value(row, column) : 0;
+}
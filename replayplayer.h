@@ -0,0 +1,93 @@
+#ifndef REPLAYPLAYER_H
+#define REPLAYPLAYER_H
+
+#include <QObject>
+#include <QVector>
+
+#include "telemetryfile.h"
+
+class QVector3D;
+
+class Submarine;
+struct SimulationSnapshot;
+
+// Plays a recorded telemetry file back into snapshots, without stepping
+// the physics
+class ReplayPlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReplayPlayer(QObject *parent = 0);
+
+    bool open(const QString &fileName, const Submarine *submarine);
+    void close();
+    bool isOpen() const;
+
+    void advance(double seconds);
+    void step();
+
+    void takeSnapshot(SimulationSnapshot *snapshot) const;
+
+    QString fileName() const;
+    QString errorString() const;
+
+    double time() const;
+    void setTime(double time);
+
+    double speed() const;
+    void setSpeed(double speed);
+
+    bool isPlaying() const;
+    void setPlaying(bool playing);
+
+    double startTime() const;
+    double endTime() const;
+
+    Q_PROPERTY(double time READ time WRITE setTime)
+    Q_PROPERTY(double speed READ speed WRITE setSpeed)
+    Q_PROPERTY(bool playing READ isPlaying WRITE setPlaying)
+    Q_PROPERTY(double startTime READ startTime)
+    Q_PROPERTY(double endTime READ endTime)
+
+private:
+    struct VectorColumns
+    {
+        int x;
+        int y;
+        int z;
+    };
+
+    VectorColumns vectorColumns(const QString &x, const QString &y, const QString &z) const;
+    QVector3D vector(qint64 row, const VectorColumns &columns) const;
+    double scalar(qint64 row, int column) const;
+
+    TelemetryFile m_file;
+    QString m_errorString;
+
+    double m_time;
+    double m_speed;
+    bool m_playing;
+
+    // column indices, -1 for columns that aren't in the file
+    VectorColumns m_position;
+    int m_rotationScalar;
+    VectorColumns m_rotationVector;
+    VectorColumns m_linearVelocity;
+    VectorColumns m_angularVelocity;
+
+    int m_roll;
+    int m_yaw;
+    int m_pitch;
+
+    int m_rollAngleOfAttack;
+    int m_yawAngleOfAttack;
+    int m_pitchAngleOfAttack;
+
+    // indexed like Submarine::forces() and Submarine::torques()
+    QVector<VectorColumns> m_forces;
+    QVector<VectorColumns> m_forcePositions;
+    QVector<VectorColumns> m_torques;
+};
+
+#endif // REPLAYPLAYER_H
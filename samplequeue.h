@@ -0,0 +1,71 @@
+#ifndef SAMPLEQUEUE_H
+#define SAMPLEQUEUE_H
+
+#include <QAtomicInt>
+#include <QVector>
+
+// Single producer, single consumer, lock-free, fixed capacity. Unlike the
+// triple buffer every pushed value is kept until it is popped, so the
+// consumer sees every physics step rather than just the latest one. When
+// the consumer falls behind by more than the capacity, new values are
+// dropped instead of blocking the producer.
+
+template <typename T>
+class SampleQueue
+{
+public:
+    explicit SampleQueue(int capacity) :
+        m_buffer(capacity + 1),
+        m_head(0),
+        m_tail(0)
+    {
+
+    }
+
+    bool push(const T &value)
+    {
+        int tail = m_tail.load();
+        int next = increment(tail);
+
+        if (next == m_head.loadAcquire()) {
+            return false;
+        }
+
+        m_buffer[tail] = value;
+        m_tail.storeRelease(next);
+
+        return true;
+    }
+
+    bool pop(T *value)
+    {
+        int head = m_head.load();
+
+        if (head == m_tail.loadAcquire()) {
+            return false;
+        }
+
+        *value = m_buffer[head];
+        m_head.storeRelease(increment(head));
+
+        return true;
+    }
+
+    void clear()
+    {
+        m_head.storeRelease(m_tail.loadAcquire());
+    }
+
+private:
+    int increment(int index) const
+    {
+        return index + 1 < m_buffer.size() ? index + 1 : 0;
+    }
+
+    QVector<T> m_buffer;
+
+    QAtomicInt m_head;  // written by the consumer
+    QAtomicInt m_tail;  // written by the producer
+};
+
+#endif // SAMPLEQUEUE_H
@@ -0,0 +1,214 @@
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QVector3D>
+
+#include "fluid.h"
+#include "simulationcore.h"
+
+#include "scenario.h"
+
+namespace {
+
+QJsonValue toJsonValue(const QVariant &value)
+{
+    if (value.userType() == QMetaType::QVector3D) {
+        QVector3D v = value.value<QVector3D>();
+        return QJsonArray() << v.x() << v.y() << v.z();
+    }
+
+    return QJsonValue::fromVariant(value);
+}
+
+QVariant fromJsonValue(const QJsonValue &value)
+{
+    if (value.isArray()) {
+        QJsonArray array = value.toArray();
+        if (array.size() == 3) {
+            return QVector3D(array[0].toDouble(), array[1].toDouble(), array[2].toDouble());
+        }
+    }
+
+    return value.toVariant();
+}
+
+void insert(QJsonObject *object, const QStringList &segments, int index, const QJsonValue &value)
+{
+    const QString &key = segments[index];
+
+    if (index == segments.size() - 1) {
+        object->insert(key, value);
+        return;
+    }
+
+    QJsonObject child = object->value(key).toObject();
+    insert(&child, segments, index + 1, value);
+    object->insert(key, child);
+}
+
+}
+
+Scenario::Scenario() :
+    m_duration(0)
+{
+
+}
+
+Scenario Scenario::capture(const SimulationCore *core, double duration)
+{
+    Scenario scenario;
+    scenario.m_values = readProperties(core);
+    scenario.m_duration = duration;
+
+    return scenario;
+}
+
+bool Scenario::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    QByteArray data = file.readAll();
+    QJsonDocument document;
+
+    if (data.startsWith("qbjs")) {
+        // validated in place, without copying or parsing
+        document = QJsonDocument::fromRawData(data.constData(), data.size(), QJsonDocument::Validate);
+        if (document.isNull()) {
+            m_errorString = "Corrupt binary scenario";
+            return false;
+        }
+    } else {
+        QJsonParseError error;
+        document = QJsonDocument::fromJson(data, &error);
+        if (document.isNull()) {
+            m_errorString = QString("%1 at offset %2").arg(error.errorString()).arg(error.offset);
+            return false;
+        }
+    }
+
+    if (!document.isObject()) {
+        m_errorString = "A scenario must be a JSON object";
+        return false;
+    }
+
+    QJsonObject object = document.object();
+
+    m_values.clear();
+    m_duration = object.value("duration").toDouble();
+
+    object.remove("duration");
+    readObject(object, QString());
+
+    return true;
+}
+
+bool Scenario::save(const QString &fileName, Format format) const
+{
+    QJsonDocument document(toJson());
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    QByteArray data = format == Binary ? document.toBinaryData() : document.toJson();
+    if (file.write(data) != data.size()) {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool Scenario::apply(SimulationCore *core, QString *error) const
+{
+    for (const auto &value : m_values) {
+        if (!writePropertyPath(core, value.first, value.second)) {
+            if (error) {
+                *error = QString("Invalid parameter \"%1\"").arg(value.first);
+            }
+            return false;
+        }
+
+        // a field file that fails to load leaves the fluid as it was
+        if (value.first == "fluid.fieldFile" && core->fluid()->fieldFile() != value.second.toString()) {
+            if (error) {
+                *error = core->fluid()->errorString();
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const PropertyValues &Scenario::values() const
+{
+    return m_values;
+}
+
+void Scenario::setValue(const QString &path, const QVariant &value)
+{
+    for (auto &existing : m_values) {
+        if (existing.first == path) {
+            existing.second = value;
+            return;
+        }
+    }
+
+    m_values.append(qMakePair(path, value));
+}
+
+double Scenario::duration() const
+{
+    return m_duration;
+}
+
+void Scenario::setDuration(double duration)
+{
+    m_duration = duration;
+}
+
+QString Scenario::errorString() const
+{
+    return m_errorString;
+}
+
+void Scenario::readObject(const QJsonObject &object, const QString &prefix)
+{
+    // an object's own properties go first, as setting them can change its
+    // children, just as readProperties() orders them
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        if (!it.value().isObject()) {
+            m_values.append(qMakePair(prefix + it.key(), fromJsonValue(it.value())));
+        }
+    }
+
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        if (it.value().isObject()) {
+            readObject(it.value().toObject(), prefix + it.key() + '.');
+        }
+    }
+}
+
+QJsonObject Scenario::toJson() const
+{
+    QJsonObject object;
+
+    if (m_duration > 0) {
+        object.insert("duration", m_duration);
+    }
+
+    for (const auto &value : m_values) {
+        insert(&object, value.first.split('.'), 0, toJsonValue(value.second));
+    }
+
+    return object;
+}
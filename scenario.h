@@ -0,0 +1,53 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <QString>
+
+#include "propertypath.h"
+
+class QJsonObject;
+
+class SimulationCore;
+
+// A declarative description of a run: property values addressed by path,
+// and how long to run for. Stored as JSON nested like the object tree, e.g.
+//
+//   { "timeStep": 0.01, "duration": 60,
+//     "submarine": { "mass": 150, "thrust": { "value": [100, 0, 10] } } }
+//
+// or as the same document in Qt's binary JSON, which loads without parsing.
+class Scenario
+{
+public:
+    enum Format {
+        Json,
+        Binary
+    };
+
+    Scenario();
+
+    static Scenario capture(const SimulationCore *core, double duration = 0);
+
+    bool load(const QString &fileName);
+    bool save(const QString &fileName, Format format = Json) const;
+
+    bool apply(SimulationCore *core, QString *error = 0) const;
+
+    const PropertyValues &values() const;
+    void setValue(const QString &path, const QVariant &value);
+
+    double duration() const;
+    void setDuration(double duration);
+
+    QString errorString() const;
+
+private:
+    void readObject(const QJsonObject &object, const QString &prefix);
+    QJsonObject toJson() const;
+
+    PropertyValues m_values;
+    double m_duration;
+    mutable QString m_errorString;
+};
+
+#endif // SCENARIO_H
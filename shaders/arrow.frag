@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec3 normal;
+in vec3 colour;
+
+out vec4 fragColor;
+
+void main()
+{
+    // lit from the camera, like the Phong materials used elsewhere
+    float diffuse = max(dot(normalize(normal), vec3(0.0, 0.0, 1.0)), 0.0);
+    fragColor = vec4(colour * (0.4 + 0.6 * diffuse), 1.0);
+}
@@ -0,0 +1,44 @@
+#version 330 core
+
+in vec3 vertexPosition;
+in vec3 vertexNormal;
+
+in vec3 instancePosition;
+in vec3 instanceDirection;
+in float instanceLength;
+in vec3 instanceColour;
+
+out vec3 normal;
+out vec3 colour;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+// the rotation taking the arrow's own axis, +y, onto direction
+mat3 rotationTo(vec3 direction)
+{
+    vec3 up = vec3(0.0, 1.0, 0.0);
+    vec3 axis = cross(up, direction);
+    float s = length(axis);
+    float c = dot(up, direction);
+
+    if (s < 1e-6) {
+        return c > 0.0 ? mat3(1.0) : mat3(1.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, -1.0);
+    }
+
+    vec3 k = axis / s;
+    mat3 K = mat3(0.0, k.z, -k.y, -k.z, 0.0, k.x, k.y, -k.x, 0.0);
+
+    return mat3(1.0) + s * K + (1.0 - c) * K * K;
+}
+
+void main()
+{
+    mat3 rotation = rotationTo(instanceDirection);
+    vec3 position = instancePosition + instanceLength * (rotation * vertexPosition);
+
+    normal = mat3(viewMatrix) * rotation * vertexNormal;
+    colour = instanceColour;
+
+    gl_Position = projectionMatrix * viewMatrix * vec4(position, 1.0);
+}
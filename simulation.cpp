@@ -1,5 +1,3 @@
-#include <bullet/btBulletDynamicsCommon.h>
-
 #include <Qt3DCore/QEntity>
 #include <Qt3DCore/QCamera>
 #include <Qt3DCore/QCameraLens>
@@ -27,31 +25,29 @@
 #include <Qt3DRenderer/QWindow>
 #include <Qt3DRenderer/QViewport>
 
-#include "fluid.h"
-#include "submarine.h"
+#include <QThread>
+
+#include "arrowrenderer.h"
+#include "assetcache.h"
 #include "forcearrow.h"
+#include "replayplayer.h"
+#include "simulationcore.h"
+#include "simulationsnapshot.h"
+#include "simulationworker.h"
+#include "submarine.h"
+#include "submarineview.h"
+#include "telemetryrecorder.h"
 
 #include "simulation.h"
 
 Simulation::Simulation() :
     Qt3D::QWindow(),
-    m_frame(0)
+    m_core(new SimulationCore()),
+    m_thread(new QThread(this)),
+    m_running(false),
+    m_recording(false),
+    m_replay(new ReplayPlayer(this))
 {
-    m_fluid = Fluid::makeDefault(this);
-    m_submarine = Submarine::makeDefault(this);
-
-    m_collisionConfiguration = new btDefaultCollisionConfiguration();
-    m_dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
-    m_pairCache = new btDbvtBroadphase();
-    m_solver = new btSequentialImpulseConstraintSolver;
-
-    m_world = new btDiscreteDynamicsWorld(m_dispatcher, m_pairCache,
-                                          m_solver, m_collisionConfiguration);
-
-    m_world->setGravity(btVector3(0, 0, 0));
-
-    m_submarine->addToWorld(m_world);
-
     m_input = new Qt3D::QInputAspect();
     registerAspect(m_input);
 
@@ -74,7 +70,18 @@ Simulation::Simulation() :
 
     setRootEntity(m_rootEntity);
 
-    m_submarine->addToScene(m_rootEntity);
+    m_assets = new AssetCache(m_rootEntity);
+    m_arrows = new ArrowRenderer(m_assets, m_rootEntity);
+    m_submarineView = new SubmarineView(m_rootEntity, m_assets, m_arrows, this);
+
+    // from here on the core belongs to the physics thread, and the scene is
+    // only updated from the snapshots it publishes
+    m_worker = new SimulationWorker(m_core);
+    m_worker->moveToThread(m_thread);
+    connect(m_worker, &SimulationWorker::recordingStopped, this, &Simulation::recordingStopped);
+    m_thread->start();
+
+    update();
 
     /*m_axisX = new ForceArrow(Qt::red, 1, m_rootEntity);
     m_axisX->addToScene(m_rootEntity);
@@ -91,69 +98,299 @@ Simulation::Simulation() :
 
 Simulation::~Simulation()
 {
-    delete m_submarine;
-    delete m_fluid;
+    pause();
 
-    delete m_world;
+    m_thread->quit();
+    m_thread->wait();
 
-    delete m_solver;
-    delete m_pairCache;
-    delete m_dispatcher;
-    delete m_collisionConfiguration;
+    delete m_worker;
 }
 
-void Simulation::step()
+void Simulation::play()
 {
-    float dt = 1.f / 60.f;
+    if (isReplaying()) {
+        m_replay->setPlaying(true);
+        m_replayClock.restart();
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_worker, "play", Qt::BlockingQueuedConnection);
+    m_running = true;
+}
 
-    m_submarine->update(m_fluid, defaultCamera());
-    m_world->stepSimulation(dt, 10);
+void Simulation::pause()
+{
+    if (isReplaying()) {
+        m_replay->setPlaying(false);
+        return;
+    }
+
+    // once this returns the physics thread is idle, so the core can be
+    // inspected and changed until the simulation is played again
+    QMetaObject::invokeMethod(m_worker, "pause", Qt::BlockingQueuedConnection);
+    m_running = false;
+}
 
-    m_frame += 1;
+void Simulation::step()
+{
+    if (isReplaying()) {
+        m_replay->step();
+        update();
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_worker, "step", Qt::BlockingQueuedConnection);
+    update();
 }
 
 void Simulation::reset()
 {
-    m_submarine->removeFromWorld(m_world);
-    delete m_world;
+    if (isReplaying()) {
+        m_replay->setTime(m_replay->startTime());
+        update();
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_worker, "reset", Qt::BlockingQueuedConnection);
+    m_worker->samples()->clear();
+    m_recording = false;
+    update();
+}
+
+bool Simulation::update()
+{
+    if (isReplaying()) {
+        m_replay->advance(m_replayClock.nsecsElapsed() / 1e9);
+        m_replayClock.restart();
+
+        m_replay->takeSnapshot(&m_replaySnapshot);
 
-    m_world = new btDiscreteDynamicsWorld(m_dispatcher, m_pairCache,
-                                          m_solver, m_collisionConfiguration);
+        const SimulationSnapshot &s = m_replaySnapshot;
+        m_submarineView->setLayout(s.layout);
+        m_submarineView->updateScene(s.position, s.rotation, s.propellorAngle, defaultCamera());
+        m_submarineView->updateArrows(s);
+        m_arrows->commit();
+        updateFleet(s.fleet, 1);
 
-    m_world->setGravity(btVector3(0, 0, 0));
+        return true;
+    }
 
-    m_submarine->addToWorld(m_world);
+    bool updated = m_worker->snapshots()->update();
+    if (updated) {
+        m_snapshotClock.restart();
+    }
 
-    m_frame = 0;
+    const SimulationSnapshot &s = snapshot();
+
+    // the scene is drawn one physics step behind, moving from the previous
+    // state to the latest one over the length of a step
+    double alpha = 1;
+    if (s.timeStep > 0) {
+        alpha = qBound(0., m_snapshotClock.nsecsElapsed() / 1e9 / s.timeStep, 1.);
+    }
+
+    QVector3D position = s.previousPosition + (s.position - s.previousPosition) * alpha;
+    QQuaternion rotation = QQuaternion::slerp(s.previousRotation, s.rotation, alpha);
+
+    // the propellor's angle is only kept modulo a turn, so it is wound back
+    // by what it turned in the step rather than interpolated
+    double propellorAngle = s.propellorAngle - s.propellorRpm * 6 * s.timeStep * (1 - alpha);
+
+    m_submarineView->setLayout(s.layout);
+    m_submarineView->updateScene(position, rotation, propellorAngle, defaultCamera());
+    if (updated) {
+        m_submarineView->updateArrows(s);
+        m_arrows->commit();
+    }
+
+    updateFleet(s.fleet, alpha);
+
+    return updated;
+}
+
+void Simulation::updateFleet(const QVector<VehicleSample> &fleet, double alpha)
+{
+    while (m_fleetEntities.size() > fleet.size()) {
+        delete m_fleetEntities.takeLast().entity;
+    }
+
+    while (m_fleetEntities.size() < fleet.size()) {
+        FleetEntity e;
+        e.entity = new Qt3D::QEntity(m_rootEntity);
+        e.entity->addComponent(m_assets->sphere());
+        e.entity->addComponent(m_assets->material(QColor(80, 80, 80)));
+
+        e.scaleTransform = new Qt3D::QScaleTransform(e.entity);
+        e.rotateTransform = new Qt3D::QRotateTransform(e.entity);
+        e.translateTransform = new Qt3D::QTranslateTransform(e.entity);
+
+        auto transform = new Qt3D::QTransform(e.entity);
+        transform->addTransform(e.scaleTransform);
+        transform->addTransform(e.rotateTransform);
+        transform->addTransform(e.translateTransform);
+        e.entity->addComponent(transform);
+
+        m_fleetEntities.append(e);
+    }
+
+    for (int i = 0; i < fleet.size(); i++) {
+        const VehicleSample &vehicle = fleet[i];
+        const FleetEntity &e = m_fleetEntities[i];
+
+        QVector3D position = vehicle.previousPosition + (vehicle.position - vehicle.previousPosition) * alpha;
+        QQuaternion rotation = QQuaternion::slerp(vehicle.previousRotation, vehicle.rotation, alpha);
+
+        float angle;
+        QVector3D axis;
+        rotation.getAxisAndAngle(&axis, &angle);
+
+        e.scaleTransform->setScale3D(vehicle.size);
+        e.rotateTransform->setAxis(axis);
+        e.rotateTransform->setAngleDeg(angle);
+        e.translateTransform->setTranslation(position);
+    }
+}
+
+QByteArray Simulation::saveState()
+{
+    QByteArray state;
+    QMetaObject::invokeMethod(m_worker, "saveState", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(QByteArray, state));
+    return state;
+}
+
+bool Simulation::restoreState(const QByteArray &state)
+{
+    bool restored = false;
+    QMetaObject::invokeMethod(m_worker, "restoreState", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, restored), Q_ARG(QByteArray, state));
+
+    m_worker->samples()->clear();
+    m_recording = false;
+    update();
+
+    return restored;
+}
+
+bool Simulation::startRecording(const QString &fileName)
+{
+    bool started = false;
+    QMetaObject::invokeMethod(m_worker, "startRecording", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(bool, started), Q_ARG(QString, fileName));
+    m_recording = started;
+    return started;
+}
+
+void Simulation::stopRecording()
+{
+    QMetaObject::invokeMethod(m_worker, "stopRecording", Qt::BlockingQueuedConnection);
+    m_recording = false;
+}
+
+bool Simulation::openReplay(const QString &fileName)
+{
+    // the live simulation stays paused for as long as the replay is open
+    pause();
+
+    if (!m_replay->open(fileName, m_core->submarine())) {
+        return false;
+    }
+
+    // the replay's forces are matched to the live submarine's, so it is
+    // drawn the same way
+    m_replaySnapshot.layout = m_worker->snapshots()->front().layout;
+
+    m_replayClock.restart();
+    update();
+
+    return true;
+}
+
+void Simulation::closeReplay()
+{
+    m_replay->close();
+
+    update();
+    m_submarineView->updateArrows(snapshot());
+    m_arrows->commit();
+}
+
+bool Simulation::isReplaying() const
+{
+    return m_replay->isOpen();
+}
+
+ReplayPlayer *Simulation::replay() const
+{
+    return m_replay;
+}
+
+bool Simulation::isRunning() const
+{
+    if (isReplaying()) {
+        return m_replay->isPlaying();
+    }
+
+    return m_running;
+}
+
+bool Simulation::isRecording() const
+{
+    return m_recording;
+}
+
+// only meaningful after startRecording() fails, when the worker is done with
+// the recorder
+QString Simulation::recordingErrorString() const
+{
+    return m_worker->recorder()->errorString();
+}
+
+const SimulationSnapshot &Simulation::snapshot() const
+{
+    if (isReplaying()) {
+        return m_replaySnapshot;
+    }
+
+    return m_worker->snapshots()->front();
+}
+
+SampleQueue<TelemetrySample> *Simulation::samples() const
+{
+    return m_worker->samples();
+}
+
+SimulationCore *Simulation::core() const
+{
+    return m_core;
 }
 
 Fluid *Simulation::fluid() const
 {
-    return m_fluid;
+    return m_core->fluid();
 }
 
 void Simulation::setFluid(Fluid *fluid)
 {
-    m_fluid = fluid;
+    m_core->setFluid(fluid);
 }
 
 Submarine *Simulation::submarine() const
 {
-    return m_submarine;
+    return m_core->submarine();
 }
 
 void Simulation::setSubmarine(Submarine *submarine)
 {
-    m_submarine = submarine;
+    m_core->setSubmarine(submarine);
 }
 
 int Simulation::frame() const
 {
-    return m_frame;
+    return snapshot().frame;
 }
 
 double Simulation::time() const
 {
-    double dt = 1.f / 60.f;
-    return m_frame * dt;
+    return snapshot().time;
 }
@@ -1,22 +1,34 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include <QElapsedTimer>
+
 #include <Qt3DRenderer/QWindow>
 
+#include "simulationsnapshot.h"
+
 namespace Qt3D {
     class QInputAspect;
     class QEntity;
+    class QRotateTransform;
+    class QScaleTransform;
+    class QTranslateTransform;
 }
 
-class btDiscreteDynamicsWorld;
-class btDefaultCollisionConfiguration;
-class btCollisionDispatcher;
-class btBroadphaseInterface;
-class btSequentialImpulseConstraintSolver;
+class QThread;
 
+class ArrowRenderer;
+class AssetCache;
 class Fluid;
 class Submarine;
+class SubmarineView;
+class SimulationCore;
+class SimulationWorker;
 class ForceArrow;
+class ReplayPlayer;
+struct TelemetrySample;
+
+template <typename T> class SampleQueue;
 
 class Simulation : public Qt3D::QWindow
 {
@@ -27,10 +39,37 @@ public:
     ~Simulation();
 
 public slots:
+    void play();
+    void pause();
     void step();
     void reset();
 
+    bool update();
+
+signals:
+    void recordingStopped(const QString &error);
+
 public:
+    QByteArray saveState();
+    bool restoreState(const QByteArray &state);
+
+    bool startRecording(const QString &fileName);
+    void stopRecording();
+
+    bool openReplay(const QString &fileName);
+    void closeReplay();
+    bool isReplaying() const;
+    ReplayPlayer *replay() const;
+
+    bool isRunning() const;
+    bool isRecording() const;
+    QString recordingErrorString() const;
+
+    const SimulationSnapshot &snapshot() const;
+    SampleQueue<TelemetrySample> *samples() const;
+
+    SimulationCore *core() const;
+
     Fluid *fluid() const;
     void setFluid(Fluid *fluid);
 
@@ -40,31 +79,52 @@ public:
     int frame() const;
     double time() const;
 
+    Q_PROPERTY(bool running READ isRunning)
+    Q_PROPERTY(bool recording READ isRecording)
+    Q_PROPERTY(bool replaying READ isReplaying)
+    Q_PROPERTY(SimulationCore *core READ core)
     Q_PROPERTY(Fluid *fluid READ fluid WRITE setFluid)
     Q_PROPERTY(Submarine *submarine READ submarine WRITE setSubmarine)
     Q_PROPERTY(int frame READ frame)
     Q_PROPERTY(double time READ time STORED false)
 
 private:
+    void updateFleet(const QVector<VehicleSample> &fleet, double alpha);
+
     // simulation
-    Fluid *m_fluid;
-    Submarine *m_submarine;
+    SimulationCore *m_core;
+    SimulationWorker *m_worker;
+    QThread *m_thread;
+    QElapsedTimer m_snapshotClock;
+    bool m_running;
+    bool m_recording;
+
+    // replay
+    ReplayPlayer *m_replay;
+    QElapsedTimer m_replayClock;
+    SimulationSnapshot m_replaySnapshot;
+
     ForceArrow *m_axisX;
     ForceArrow *m_axisY;
     ForceArrow *m_axisZ;
 
-    int m_frame;
-
-    // physics
-    btDiscreteDynamicsWorld *m_world;
-    btDefaultCollisionConfiguration* m_collisionConfiguration;
-    btCollisionDispatcher* m_dispatcher;
-    btBroadphaseInterface* m_pairCache;
-    btSequentialImpulseConstraintSolver* m_solver;
-
     // graphics
     Qt3D::QInputAspect *m_input;
     Qt3D::QEntity *m_rootEntity;
+    AssetCache *m_assets;
+    ArrowRenderer *m_arrows;
+    SubmarineView *m_submarineView;
+
+    // every submarine but the followed one, drawn as a plain hull
+    struct FleetEntity
+    {
+        Qt3D::QEntity *entity;
+        Qt3D::QScaleTransform *scaleTransform;
+        Qt3D::QRotateTransform *rotateTransform;
+        Qt3D::QTranslateTransform *translateTransform;
+    };
+
+    QVector<FleetEntity> m_fleetEntities;
 };
 
 #endif // SIMULATION_H
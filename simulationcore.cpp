@@ -0,0 +1,549 @@
+#include <QDataStream>
+#include <QtConcurrent>
+#include <QtDebug>
+
+#include <bullet/btBulletDynamicsCommon.h>
+
+#include "fluid.h"
+#include "physics/body.h"
+#include "physics/force.h"
+#include "physics/torque.h"
+#include "propertypath.h"
+#include "samplequeue.h"
+#include "simulationsnapshot.h"
+#include "submarine.h"
+#include "telemetryrecorder.h"
+
+#include "simulationcore.h"
+
+namespace {
+
+const quint32 StateMagic = 0x53554253;  // "SUBS"
+const quint32 StateVersion = 3;
+
+// submarines added to the fleet start abreast of the first, this far apart
+const float FleetSpacing = 5;  // m
+
+// smaller steps, or none at all, would keep advance() and batch runs from
+// ever catching up with the clock
+const double MinimumTimeStep = 1e-4;  // s
+
+// Submarines only interact once Bullet steps them together, so up to then
+// each is worked on independently, in chunks spread over the thread pool.
+// A fleet of a single chunk stays on the calling thread, which is what
+// keeps sweeps and ensembles, already a run per core, from oversubscribing.
+const int FleetChunkSize = 16;
+
+template <typename Function>
+void forEachSubmarine(const QVector<Submarine *> &submarines, Function function)
+{
+    if (submarines.size() <= FleetChunkSize) {
+        for (Submarine *submarine : submarines) {
+            function(submarine);
+        }
+
+        return;
+    }
+
+    QVector<int> chunks;
+    for (int begin = 0; begin < submarines.size(); begin += FleetChunkSize) {
+        chunks.append(begin);
+    }
+
+    QtConcurrent::blockingMap(chunks, [&submarines, &function](int begin) {
+        int end = qMin(begin + FleetChunkSize, submarines.size());
+        for (int i = begin; i < end; i++) {
+            function(submarines[i]);
+        }
+    });
+}
+
+}
+
+SimulationCore::SimulationCore(QObject *parent) :
+    QObject(parent),
+    m_timeStep(1. / 60.),
+    m_maxFrameTime(0.25),
+    m_accumulator(0),
+    m_frame(0),
+    m_time(0),
+    m_sampleQueue(0),
+    m_recorder(0)
+{
+    m_fluid = Fluid::makeDefault(this);
+    m_submarine = Submarine::makeDefault(this);
+
+    m_fluid->setObjectName("fluid");
+    m_submarine->setObjectName("submarine");
+
+    m_collisionConfiguration = new btDefaultCollisionConfiguration();
+    m_dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+    m_pairCache = new btDbvtBroadphase();
+    m_solver = new btSequentialImpulseConstraintSolver;
+
+    makeWorld();
+
+    m_submarine->addToWorld(m_world);
+    m_submarines.append(m_submarine);
+    m_inherited.resize(1);
+    updateKinematics();
+
+    storePreviousState();
+}
+
+SimulationCore::~SimulationCore()
+{
+    qDeleteAll(m_submarines);
+    delete m_fluid;
+
+    delete m_world;
+
+    delete m_solver;
+    delete m_pairCache;
+    delete m_dispatcher;
+    delete m_collisionConfiguration;
+}
+
+void SimulationCore::step()
+{
+    storePreviousState();
+
+    updateForces();
+    m_world->stepSimulation(m_timeStep, 0);
+
+    m_frame += 1;
+    m_time += m_timeStep;
+
+    updateKinematics();
+
+    if (m_sampleQueue) {
+        TelemetrySample sample;
+        takeSample(&sample);
+        m_sampleQueue->push(sample);
+    }
+
+    if (m_recorder) {
+        m_recorder->record(this);
+    }
+}
+
+void SimulationCore::reset()
+{
+    // the lead may have been changed or moved since the followers were made
+    for (int i = 1; i < m_submarines.size(); i++) {
+        inheritFromLead(i);
+    }
+
+    for (Submarine *submarine : m_submarines) {
+        submarine->resetInWorld(m_world);
+    }
+
+    m_world->clearForces();
+    m_solver->reset();
+
+    m_accumulator = 0;
+    m_frame = 0;
+    m_time = 0;
+
+    updateKinematics();
+    storePreviousState();
+}
+
+QByteArray SimulationCore::saveState() const
+{
+    QByteArray state;
+    QDataStream out(&state, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_5);
+
+    PropertyValues parameters = readProperties(this);
+
+    out << StateMagic << StateVersion;
+    out << qint32(m_frame) << m_time << m_accumulator;
+
+    out << qint32(parameters.size());
+    for (const auto &parameter : parameters) {
+        out << parameter.first << parameter.second;
+    }
+
+    // the parameters include fleetSize, so restoring them brings back the
+    // same number of submarines
+    out << qint32(m_submarines.size());
+    for (int i = 0; i < m_submarines.size(); i++) {
+        out << m_previousPositions[i] << m_previousRotations[i];
+        m_submarines[i]->saveState(out);
+    }
+
+    return state;
+}
+
+bool SimulationCore::restoreState(const QByteArray &state)
+{
+    QDataStream in(state);
+    in.setVersion(QDataStream::Qt_5_5);
+
+    quint32 magic, version;
+    in >> magic >> version;
+    if (magic != StateMagic || version != StateVersion) {
+        return false;
+    }
+
+    qint32 frame;
+    double time, accumulator;
+    qint32 parameterCount;
+
+    in >> frame >> time >> accumulator;
+    in >> parameterCount;
+
+    PropertyValues parameters;
+    for (int i = 0; i < parameterCount && in.status() == QDataStream::Ok; i++) {
+        QString path;
+        QVariant value;
+        in >> path >> value;
+        parameters.append(qMakePair(path, value));
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    // from here on a failure leaves a mix of states, which only a reset
+    // cleans up
+    for (const auto &parameter : parameters) {
+        if (!writePropertyPath(this, parameter.first, parameter.second)) {
+            qWarning() << "Could not restore" << parameter.first;
+        }
+    }
+
+    m_world->clearForces();
+    m_solver->reset();
+
+    qint32 submarineCount;
+    in >> submarineCount;
+    if (submarineCount != m_submarines.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < m_submarines.size(); i++) {
+        in >> m_previousPositions[i] >> m_previousRotations[i];
+
+        if (!m_submarines[i]->restoreState(in, m_world)) {
+            return false;
+        }
+    }
+
+    m_frame = frame;
+    m_time = time;
+    m_accumulator = accumulator;
+
+    updateKinematics();
+
+    return true;
+}
+
+int SimulationCore::advance(double seconds)
+{
+    // a long frame is clamped rather than caught up on, so that a stall
+    // can't snowball into ever longer frames
+    m_accumulator += qMin(seconds, m_maxFrameTime);
+
+    int steps = 0;
+    while (m_accumulator >= m_timeStep) {
+        step();
+
+        m_accumulator -= m_timeStep;
+        steps++;
+    }
+
+    return steps;
+}
+
+void SimulationCore::takeSnapshot(SimulationSnapshot *snapshot) const
+{
+    const Physics::Body *body = m_submarine->body();
+
+    snapshot->frame = m_frame;
+    snapshot->time = m_time;
+    snapshot->timeStep = m_timeStep;
+
+    snapshot->previousPosition = m_previousPositions[0];
+    snapshot->previousRotation = m_previousRotations[0];
+
+    snapshot->position = body->position();
+    snapshot->rotation = body->rotation();
+
+    snapshot->linearVelocity = body->linearVelocity();
+    snapshot->angularVelocity = body->angularVelocity();
+
+    snapshot->roll = body->roll();
+    snapshot->yaw = body->yaw();
+    snapshot->pitch = body->pitch();
+
+    snapshot->rollAngleOfAttack = body->rollAngleOfAttack();
+    snapshot->yawAngleOfAttack = body->yawAngleOfAttack();
+    snapshot->pitchAngleOfAttack = body->pitchAngleOfAttack();
+
+    snapshot->propellorAngle = m_submarine->propellorAngle();
+    snapshot->propellorRpm = m_submarine->propellorRpm();
+
+    snapshot->layout = m_submarine->layout();
+
+    const QVector<Physics::Force *> &forces = m_submarine->forces();
+    snapshot->forces.resize(forces.size());
+    for (int i = 0; i < forces.size(); i++) {
+        snapshot->forces[i].value = forces[i]->force();
+        snapshot->forces[i].position = forces[i]->worldPosition();
+    }
+
+    const QVector<Physics::Torque *> &torques = m_submarine->torques();
+    snapshot->torques.resize(torques.size());
+    for (int i = 0; i < torques.size(); i++) {
+        snapshot->torques[i].value = torques[i]->value();
+        snapshot->torques[i].position = snapshot->position;
+    }
+
+    snapshot->fleet.resize(m_submarines.size() - 1);
+    for (int i = 1; i < m_submarines.size(); i++) {
+        const Submarine *submarine = m_submarines[i];
+        VehicleSample &vehicle = snapshot->fleet[i - 1];
+
+        vehicle.previousPosition = m_previousPositions[i];
+        vehicle.previousRotation = m_previousRotations[i];
+        vehicle.position = submarine->body()->position();
+        vehicle.rotation = submarine->body()->rotation();
+        vehicle.size = QVector3D(submarine->length(), submarine->height(), submarine->width());
+    }
+}
+
+void SimulationCore::takeSample(TelemetrySample *sample) const
+{
+    const Physics::Body *body = m_submarine->body();
+
+    sample->time = m_time;
+
+    sample->position = body->position();
+    sample->linearVelocity = body->linearVelocity();
+    sample->angularVelocity = body->angularVelocity();
+
+    sample->roll = body->roll();
+    sample->yaw = body->yaw();
+    sample->pitch = body->pitch();
+
+    sample->rollAngleOfAttack = body->rollAngleOfAttack();
+    sample->yawAngleOfAttack = body->yawAngleOfAttack();
+    sample->pitchAngleOfAttack = body->pitchAngleOfAttack();
+}
+
+void SimulationCore::updateForces()
+{
+    forEachSubmarine(m_submarines, [this](Submarine *submarine) {
+        submarine->updateForces(m_fluid, m_time);
+        submarine->updatePropellor(m_timeStep);
+    });
+}
+
+void SimulationCore::updateKinematics()
+{
+    forEachSubmarine(m_submarines, [this](Submarine *submarine) {
+        updateKinematics(submarine);
+    });
+}
+
+void SimulationCore::updateKinematics(Submarine *submarine)
+{
+    // the current is sampled once per step, at the body, and every
+    // hydrodynamic force works from the body's velocity relative to it
+    Physics::Body *body = submarine->body();
+    const btVector3 &p = body->body()->getCenterOfMassPosition();
+    const btVector3 &v = body->body()->getLinearVelocity();
+
+    QVector3D position(p.x(), p.y(), p.z());
+
+    body->updateKinematics(m_fluid->sample(position, m_time).current);
+
+    // a streamed field reads ahead along the body's path
+    m_fluid->prefetch(submarine, position, QVector3D(v.x(), v.y(), v.z()), m_time);
+}
+
+void SimulationCore::storePreviousState()
+{
+    m_previousPositions.resize(m_submarines.size());
+    m_previousRotations.resize(m_submarines.size());
+
+    for (int i = 0; i < m_submarines.size(); i++) {
+        m_previousPositions[i] = m_submarines[i]->body()->position();
+        m_previousRotations[i] = m_submarines[i]->body()->rotation();
+    }
+}
+
+void SimulationCore::makeWorld()
+{
+    m_world = new btDiscreteDynamicsWorld(m_dispatcher, m_pairCache,
+                                          m_solver, m_collisionConfiguration);
+
+    m_world->setGravity(btVector3(0, 0, 0));
+}
+
+Fluid *SimulationCore::fluid() const
+{
+    return m_fluid;
+}
+
+void SimulationCore::setFluid(Fluid *fluid)
+{
+    m_fluid = fluid;
+}
+
+Submarine *SimulationCore::submarine() const
+{
+    return m_submarine;
+}
+
+void SimulationCore::setSubmarine(Submarine *submarine)
+{
+    m_submarine = submarine;
+    m_submarines[0] = submarine;
+}
+
+const QVector<Submarine *> &SimulationCore::submarines() const
+{
+    return m_submarines;
+}
+
+int SimulationCore::fleetSize() const
+{
+    return m_submarines.size();
+}
+
+void SimulationCore::setFleetSize(int fleetSize)
+{
+    fleetSize = qMax(1, fleetSize);
+
+    while (m_submarines.size() > fleetSize) {
+        Submarine *submarine = m_submarines.takeLast();
+        submarine->removeFromWorld(m_world);
+        delete submarine;
+    }
+
+    int first = m_submarines.size();
+    m_inherited.resize(fleetSize);
+
+    while (m_submarines.size() < fleetSize) {
+        int index = m_submarines.size();
+
+        Submarine *submarine = new Submarine(this);
+        submarine->setObjectName(QString("submarine%1").arg(index + 1));
+
+        m_submarines.append(submarine);
+        inheritFromLead(index);
+
+        submarine->addToWorld(m_world);
+        updateKinematics(submarine);
+    }
+
+    m_previousPositions.resize(fleetSize);
+    m_previousRotations.resize(fleetSize);
+
+    for (int i = first; i < fleetSize; i++) {
+        m_previousPositions[i] = m_submarines[i]->body()->position();
+        m_previousRotations[i] = m_submarines[i]->body()->rotation();
+    }
+}
+
+// A follower is built like the lead and starts abreast of it, except for
+// whatever has been set on the follower itself since it last took over the
+// lead's values. Scenarios set fleetSize before they set up the lead, so
+// this is done again at every reset.
+void SimulationCore::inheritFromLead(int index)
+{
+    Submarine *follower = m_submarines[index];
+    QHash<QString, QVariant> &inherited = m_inherited[index];
+
+    PropertyValues values = readProperties(m_submarine);
+
+    for (auto &value : values) {
+        if (value.first == "initialPosition") {
+            value.second = m_submarine->initialPosition() + QVector3D(0, 0, index * FleetSpacing);
+        }
+
+        bool ok;
+        QVariant current = readPropertyPath(follower, value.first, &ok);
+
+        // e.g. a fin the follower doesn't have yet, which its own fin
+        // settings will make
+        if (!ok) {
+            continue;
+        }
+
+        if (inherited.contains(value.first) && current != inherited.value(value.first)) {
+            continue;
+        }
+
+        writePropertyPath(follower, value.first, value.second);
+        inherited.insert(value.first, value.second);
+    }
+}
+
+SampleQueue<TelemetrySample> *SimulationCore::sampleQueue() const
+{
+    return m_sampleQueue;
+}
+
+void SimulationCore::setSampleQueue(SampleQueue<TelemetrySample> *sampleQueue)
+{
+    m_sampleQueue = sampleQueue;
+}
+
+TelemetryRecorder *SimulationCore::recorder() const
+{
+    return m_recorder;
+}
+
+void SimulationCore::setRecorder(TelemetryRecorder *recorder)
+{
+    m_recorder = recorder;
+}
+
+btDiscreteDynamicsWorld *SimulationCore::world() const
+{
+    return m_world;
+}
+
+double SimulationCore::timeStep() const
+{
+    return m_timeStep;
+}
+
+void SimulationCore::setTimeStep(double timeStep)
+{
+    if (!qIsFinite(timeStep)) {
+        qWarning() << "Ignoring time step" << timeStep;
+        return;
+    }
+
+    if (timeStep < MinimumTimeStep) {
+        qWarning() << "Time step" << timeStep << "raised to" << MinimumTimeStep;
+        timeStep = MinimumTimeStep;
+    }
+
+    m_timeStep = timeStep;
+}
+
+double SimulationCore::maxFrameTime() const
+{
+    return m_maxFrameTime;
+}
+
+void SimulationCore::setMaxFrameTime(double maxFrameTime)
+{
+    m_maxFrameTime = maxFrameTime;
+}
+
+int SimulationCore::frame() const
+{
+    return m_frame;
+}
+
+double SimulationCore::time() const
+{
+    return m_time;
+}
@@ -0,0 +1,124 @@
+#ifndef SIMULATIONCORE_H
+#define SIMULATIONCORE_H
+
+#include <QHash>
+#include <QObject>
+#include <QQuaternion>
+#include <QString>
+#include <QVariant>
+#include <QVector3D>
+#include <QVector>
+
+class btDiscreteDynamicsWorld;
+class btDefaultCollisionConfiguration;
+class btCollisionDispatcher;
+class btBroadphaseInterface;
+class btSequentialImpulseConstraintSolver;
+
+template <typename T> class SampleQueue;
+
+class Fluid;
+class Submarine;
+struct SimulationSnapshot;
+struct TelemetrySample;
+class TelemetryRecorder;
+
+class SimulationCore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SimulationCore(QObject *parent = 0);
+    ~SimulationCore();
+
+public slots:
+    void step();
+    void reset();
+
+public:
+    int advance(double seconds);
+
+    void takeSnapshot(SimulationSnapshot *snapshot) const;
+    void takeSample(TelemetrySample *sample) const;
+
+    QByteArray saveState() const;
+    bool restoreState(const QByteArray &state);
+
+    SampleQueue<TelemetrySample> *sampleQueue() const;
+    void setSampleQueue(SampleQueue<TelemetrySample> *sampleQueue);
+
+    TelemetryRecorder *recorder() const;
+    void setRecorder(TelemetryRecorder *recorder);
+
+public:
+    Fluid *fluid() const;
+    void setFluid(Fluid *fluid);
+
+    Submarine *submarine() const;
+    void setSubmarine(Submarine *submarine);
+
+    // the first is submarine(), the one charted, recorded and followed
+    const QVector<Submarine *> &submarines() const;
+
+    int fleetSize() const;
+    void setFleetSize(int fleetSize);
+
+    btDiscreteDynamicsWorld *world() const;
+
+    double timeStep() const;
+    void setTimeStep(double timeStep);
+
+    double maxFrameTime() const;
+    void setMaxFrameTime(double maxFrameTime);
+
+    int frame() const;
+    double time() const;
+
+    Q_PROPERTY(Fluid *fluid READ fluid WRITE setFluid)
+    Q_PROPERTY(Submarine *submarine READ submarine WRITE setSubmarine)
+    Q_PROPERTY(double timeStep READ timeStep WRITE setTimeStep)
+    Q_PROPERTY(double maxFrameTime READ maxFrameTime WRITE setMaxFrameTime)
+    Q_PROPERTY(int fleetSize READ fleetSize WRITE setFleetSize)
+    Q_PROPERTY(int frame READ frame)
+    Q_PROPERTY(double time READ time)
+
+private:
+    void makeWorld();
+    void updateForces();
+    void updateKinematics();
+    void updateKinematics(Submarine *submarine);
+    void storePreviousState();
+    void inheritFromLead(int index);
+
+    // simulation
+    Fluid *m_fluid;
+    Submarine *m_submarine;
+    QVector<Submarine *> m_submarines;
+
+    double m_timeStep;
+    double m_maxFrameTime;
+    double m_accumulator;
+
+    int m_frame;
+    double m_time;
+
+    // indexed like m_submarines
+    QVector<QVector3D> m_previousPositions;
+    QVector<QQuaternion> m_previousRotations;
+
+    // the lead's values each follower last took over, by path, to tell
+    // them apart from values set on the follower itself
+    QVector<QHash<QString, QVariant> > m_inherited;
+
+    SampleQueue<TelemetrySample> *m_sampleQueue;
+    TelemetryRecorder *m_recorder;
+
+    // physics
+    btDiscreteDynamicsWorld *m_world;
+    btDefaultCollisionConfiguration* m_collisionConfiguration;
+    btCollisionDispatcher* m_dispatcher;
+    btBroadphaseInterface* m_pairCache;
+    btSequentialImpulseConstraintSolver* m_solver;
+};
+
+#endif // SIMULATIONCORE_H
@@ -1,6 +1,7 @@
 #include "physics/force.h"
 #include "physics/torque.h"
 #include "simulation.h"
+#include "simulationcore.h"
 #include "fluid.h"
 #include "submarine.h"
 
@@ -23,12 +24,16 @@ SimulationPropertiesDialogue::~SimulationPropertiesDialogue()
 
 void SimulationPropertiesDialogue::loadSimulation(const Simulation *simulation)
 {
+    ui->spinPhysicsRate->setValue(1. / simulation->core()->timeStep());
+
     loadFluid(simulation->fluid());
     loadSubmarine(simulation->submarine());
 }
 
 void SimulationPropertiesDialogue::saveSimulation(Simulation *simulation) const
 {
+    simulation->core()->setTimeStep(1. / ui->spinPhysicsRate->value());
+
     saveFluid(simulation->fluid());
     saveSubmarine(simulation->submarine());
 }
@@ -0,0 +1,128 @@
+#ifndef SIMULATIONSNAPSHOT_H
+#define SIMULATIONSNAPSHOT_H
+
+#include <QQuaternion>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector3D>
+#include <QVector>
+
+struct ForceSample
+{
+    QVector3D value;
+    QVector3D position;
+};
+
+// the per-step values that are charted
+struct TelemetrySample
+{
+    TelemetrySample() :
+        time(0),
+        roll(0),
+        yaw(0),
+        pitch(0),
+        rollAngleOfAttack(0),
+        yawAngleOfAttack(0),
+        pitchAngleOfAttack(0)
+    {
+
+    }
+
+    double time;
+
+    QVector3D position;
+    QVector3D linearVelocity;
+    QVector3D angularVelocity;
+
+    double roll;
+    double yaw;
+    double pitch;
+
+    double rollAngleOfAttack;
+    double yawAngleOfAttack;
+    double pitchAngleOfAttack;
+};
+
+// the pose of a submarine other than the one followed
+struct VehicleSample
+{
+    QVector3D previousPosition;
+    QQuaternion previousRotation;
+
+    QVector3D position;
+    QQuaternion rotation;
+
+    QVector3D size;  // length, height and width
+};
+
+struct FinLayout
+{
+    float position;  // along the hull
+    float radius;  // from the hull's axis to the fin's root
+    float angle;  // about the hull's axis, in degrees from the top
+};
+
+// how the followed submarine is built, which only changes when it is reset,
+// so that the scene can be drawn without touching the simulation
+struct SubmarineLayout
+{
+    QVector3D size;  // length, height and width
+    QVector<FinLayout> fins;
+
+    // paths below the submarine, e.g. "northFin.lift", indexed like the
+    // snapshot's forces and torques
+    QStringList forces;
+    QStringList torques;
+};
+
+struct SimulationSnapshot
+{
+    SimulationSnapshot() :
+        frame(0),
+        time(0),
+        timeStep(0),
+        roll(0),
+        yaw(0),
+        pitch(0),
+        rollAngleOfAttack(0),
+        yawAngleOfAttack(0),
+        pitchAngleOfAttack(0),
+        propellorAngle(0),
+        propellorRpm(0)
+    {
+
+    }
+
+    int frame;
+    double time;
+    double timeStep;
+
+    QVector3D previousPosition;
+    QQuaternion previousRotation;
+
+    QVector3D position;
+    QQuaternion rotation;
+
+    QVector3D linearVelocity;
+    QVector3D angularVelocity;
+
+    double roll;
+    double yaw;
+    double pitch;
+
+    double rollAngleOfAttack;
+    double yawAngleOfAttack;
+    double pitchAngleOfAttack;
+
+    double propellorAngle;  // degrees
+    double propellorRpm;
+
+    QSharedPointer<const SubmarineLayout> layout;
+
+    QVector<ForceSample> forces;
+    QVector<ForceSample> torques;
+
+    QVector<VehicleSample> fleet;
+};
+
+#endif // SIMULATIONSNAPSHOT_H
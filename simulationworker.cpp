@@ -0,0 +1,130 @@
+#include <QTimer>
+
+#include "simulationcore.h"
+
+#include "simulationworker.h"
+
+SimulationWorker::SimulationWorker(SimulationCore *core, QObject *parent) :
+    QObject(parent),
+    m_core(core),
+    m_timer(new QTimer(this)),
+    m_samples(4096)
+{
+    m_core->setParent(this);
+    m_core->setSampleQueue(&m_samples);
+
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &SimulationWorker::advance);
+
+    publish();
+}
+
+void SimulationWorker::play()
+{
+    m_clock.restart();
+    m_timer->start(qMax(1, int(m_core->timeStep() * 1000)));
+}
+
+void SimulationWorker::pause()
+{
+    m_timer->stop();
+}
+
+void SimulationWorker::step()
+{
+    m_core->step();
+    checkRecording();
+    publish();
+}
+
+void SimulationWorker::reset()
+{
+    // a recording covers a single run, so that its time column never goes back
+    stopRecording();
+
+    m_core->reset();
+    m_clock.restart();
+    publish();
+}
+
+bool SimulationWorker::startRecording(const QString &fileName)
+{
+    stopRecording();
+
+    if (!m_recorder.open(fileName, m_core)) {
+        return false;
+    }
+
+    m_recorder.record(m_core);
+    m_core->setRecorder(&m_recorder);
+
+    return true;
+}
+
+void SimulationWorker::stopRecording()
+{
+    m_core->setRecorder(0);
+    m_recorder.close();
+}
+
+QByteArray SimulationWorker::saveState() const
+{
+    return m_core->saveState();
+}
+
+bool SimulationWorker::restoreState(const QByteArray &state)
+{
+    // like a reset, a restore takes the time back
+    stopRecording();
+
+    bool restored = m_core->restoreState(state);
+    m_clock.restart();
+    publish();
+
+    return restored;
+}
+
+void SimulationWorker::advance()
+{
+    double elapsed = m_clock.nsecsElapsed() / 1e9;
+    m_clock.restart();
+
+    if (m_core->advance(elapsed) > 0) {
+        checkRecording();
+        publish();
+    }
+}
+
+void SimulationWorker::publish()
+{
+    m_core->takeSnapshot(&m_snapshots.back());
+    m_snapshots.publish();
+}
+
+void SimulationWorker::checkRecording()
+{
+    if (m_core->recorder() && !m_recorder.isOpen()) {
+        m_core->setRecorder(0);
+        emit recordingStopped(m_recorder.errorString());
+    }
+}
+
+SimulationCore *SimulationWorker::core() const
+{
+    return m_core;
+}
+
+TripleBuffer<SimulationSnapshot> *SimulationWorker::snapshots()
+{
+    return &m_snapshots;
+}
+
+SampleQueue<TelemetrySample> *SimulationWorker::samples()
+{
+    return &m_samples;
+}
+
+TelemetryRecorder *SimulationWorker::recorder()
+{
+    return &m_recorder;
+}
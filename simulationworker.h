@@ -0,0 +1,65 @@
+#ifndef SIMULATIONWORKER_H
+#define SIMULATIONWORKER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include "samplequeue.h"
+#include "simulationsnapshot.h"
+#include "telemetryrecorder.h"
+#include "triplebuffer.h"
+
+class QTimer;
+
+class SimulationCore;
+
+class SimulationWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SimulationWorker(SimulationCore *core, QObject *parent = 0);
+
+public slots:
+    void play();
+    void pause();
+    void step();
+    void reset();
+
+    bool startRecording(const QString &fileName);
+    void stopRecording();
+
+    QByteArray saveState() const;
+    bool restoreState(const QByteArray &state);
+
+signals:
+    // the recorder closed its file by itself, e.g. because it couldn't grow
+    void recordingStopped(const QString &error);
+
+private slots:
+    void advance();
+
+private:
+    void publish();
+    void checkRecording();
+
+public:
+    SimulationCore *core() const;
+
+    TripleBuffer<SimulationSnapshot> *snapshots();
+    SampleQueue<TelemetrySample> *samples();
+    TelemetryRecorder *recorder();
+
+    Q_PROPERTY(SimulationCore *core READ core)
+
+private:
+    SimulationCore *m_core;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+
+    TripleBuffer<SimulationSnapshot> m_snapshots;
+    SampleQueue<TelemetrySample> m_samples;
+    TelemetryRecorder m_recorder;
+};
+
+#endif // SIMULATIONWORKER_H
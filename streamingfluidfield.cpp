@@ -0,0 +1,447 @@
+#include <QSet>
+#include <QThread>
+#include <QtDebug>
+
+#include <algorithm>
+#include <cmath>
+
+#include "streamingfluidfield.h"
+
+using FluidFieldFormat::BrickSize;
+using FluidFieldFormat::BrickNodes;
+using FluidFieldFormat::Node;
+
+namespace {
+
+const qint64 TileSize = BrickNodes * sizeof(Node);
+const int PageSize = 4096;
+
+// how far ahead prefetching follows a path, and how finely
+const double Lookahead = 5;  // s
+const int MaxPathPoints = 64;
+
+}
+
+class StreamingFluidField::Prefetcher : public QThread
+{
+public:
+    explicit Prefetcher(StreamingFluidField *field) :
+        m_field(field)
+    {
+
+    }
+
+protected:
+    void run()
+    {
+        m_field->prefetchTiles();
+    }
+
+private:
+    StreamingFluidField *m_field;
+};
+
+StreamingFluidField::StreamingFluidField() :
+    m_frameBricks(0),
+    m_nodesOffset(0),
+    m_capacity(DefaultResidentTiles),
+    m_mapFailed(false),
+    m_stopping(false),
+    m_prefetcher(0)
+{
+
+}
+
+StreamingFluidField::~StreamingFluidField()
+{
+    if (m_prefetcher) {
+        m_mutex.lock();
+        m_stopping = true;
+        m_hintsChanged.wakeAll();
+        m_mutex.unlock();
+
+        m_prefetcher->wait();
+        delete m_prefetcher;
+    }
+
+    for (const Tile &tile : m_tiles) {
+        m_file.unmap(reinterpret_cast<uchar *>(const_cast<Node *>(tile.nodes)));
+    }
+}
+
+StreamingFluidField *StreamingFluidField::open(const QString &fileName, int residentTiles, QString *error)
+{
+    StreamingFluidField *field = new StreamingFluidField();
+
+    field->m_file.setFileName(fileName);
+    if (!field->m_file.open(QIODevice::ReadOnly)) {
+        *error = field->m_file.errorString();
+        delete field;
+        return 0;
+    }
+
+    FluidFieldFormat::Header header;
+    if (!FluidFieldFormat::readHeader(&field->m_file, &header, &field->m_frameTimes, error)) {
+        delete field;
+        return 0;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        field->m_origin[axis] = header.origin[axis];
+        field->m_spacing[axis] = header.spacing[axis];
+        field->m_size[axis] = qMax(1u, header.size[axis]);
+        field->m_bricks[axis] = (field->m_size[axis] + BrickSize - 1) / BrickSize;
+    }
+
+    field->m_frameBricks = field->m_bricks[0] * field->m_bricks[1] * field->m_bricks[2];
+    field->m_nodesOffset = field->m_file.pos();
+
+    // check up front that every tile is there to be mapped
+    qint64 nodesSize = field->m_frameTimes.size() * field->m_frameBricks * TileSize;
+    if (field->m_file.size() < field->m_nodesOffset + nodesSize) {
+        *error = "Truncated fluid field file";
+        delete field;
+        return 0;
+    }
+
+    field->m_capacity = qMax(16, residentTiles);
+
+    // what sample() falls back on if it can't map any of the tiles it needs
+    FluidFieldFormat::Cell cell = FluidFieldFormat::locateCell(field->m_origin, field->m_origin,
+                                                               field->m_spacing, field->m_size);
+    qint64 keys[8];
+    const Node *tiles[8];
+
+    if (!field->pinFrame(0, cell, keys, tiles)) {
+        *error = QString("Could not map fluid field tile: %1").arg(field->m_file.errorString());
+        delete field;
+        return 0;
+    }
+
+    field->sampleFrame(tiles, cell, 1, &field->m_fallback);
+
+    for (qint64 key : keys) {
+        field->unpin(key);
+    }
+
+    field->m_prefetcher = new Prefetcher(field);
+    field->m_prefetcher->start(QThread::LowPriority);
+
+    return field;
+}
+
+FluidSample StreamingFluidField::sample(const QVector3D &position, double time) const
+{
+    FluidFieldFormat::Cell cell = FluidFieldFormat::locateCell(position, m_origin, m_spacing, m_size);
+
+    float t;
+    int frame = FluidFieldFormat::locateFrame(m_frameTimes.constData(), m_frameTimes.size(), time, &t);
+
+    // the lock is only held to pin the corners' tiles and to unpin them
+    // again, not while interpolating
+    qint64 keys[16];
+    const Node *tiles[16];
+    float weights[2] = { 1 - t, t };
+
+    QMutexLocker locker(&m_mutex);
+
+    bool first = pinFrame(frame, cell, keys, tiles);
+    bool second = t > 0 && pinFrame(frame + 1, cell, keys + 8, tiles + 8);
+    int frames = first + second;
+
+    if (frames < (t > 0 ? 2 : 1)) {
+        if (!m_mapFailed) {
+            qWarning("Could not map fluid field tile, sampling nearby instead: %s",
+                     qPrintable(m_file.errorString()));
+            m_mapFailed = true;
+        }
+
+        if (second) {
+            std::copy(keys + 8, keys + 16, keys);
+            std::copy(tiles + 8, tiles + 16, tiles);
+        } else if (!first) {
+            int resident = nearestResidentFrame(frame, cell);
+            if (resident < 0 || !pinFrame(resident, cell, keys, tiles)) {
+                return m_fallback;
+            }
+        }
+
+        frames = 1;
+        weights[0] = 1;
+    }
+
+    locker.unlock();
+
+    FluidSample sample;
+
+    sampleFrame(tiles, cell, weights[0], &sample);
+    if (frames > 1) {
+        sampleFrame(tiles + 8, cell, weights[1], &sample);
+    }
+
+    locker.relock();
+    for (int i = 0; i < frames * 8; i++) {
+        unpin(keys[i]);
+    }
+
+    return sample;
+}
+
+void StreamingFluidField::prefetch(const void *source, const QVector3D &position, const QVector3D &velocity,
+                                   double time) const
+{
+    Hint hint;
+    hint.position = position;
+    hint.velocity = velocity;
+    hint.time = time;
+
+    QMutexLocker locker(&m_mutex);
+
+    // a hint not yet acted on is out of date by now
+    m_hints.insert(source, hint);
+    m_hintsChanged.wakeOne();
+}
+
+int StreamingFluidField::residentTiles() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tiles.size();
+}
+
+qint64 StreamingFluidField::tileKey(int frame, const FluidFieldFormat::Cell &cell, int corner) const
+{
+    int x = corner & 1 ? cell.upper[0] : cell.lower[0];
+    int y = corner & 2 ? cell.upper[1] : cell.lower[1];
+    int z = corner & 4 ? cell.upper[2] : cell.lower[2];
+
+    return qint64(frame) * m_frameBricks + FluidFieldFormat::brickIndex(x, y, z, m_bricks);
+}
+
+void StreamingFluidField::sampleFrame(const Node *const tiles[8], const FluidFieldFormat::Cell &cell,
+                                      float frameWeight, FluidSample *sample) const
+{
+    for (int corner = 0; corner < 8; corner++) {
+        int x = corner & 1 ? cell.upper[0] : cell.lower[0];
+        int y = corner & 2 ? cell.upper[1] : cell.lower[1];
+        int z = corner & 4 ? cell.upper[2] : cell.lower[2];
+
+        float w = frameWeight;
+        w *= corner & 1 ? cell.weights[0] : 1 - cell.weights[0];
+        w *= corner & 2 ? cell.weights[1] : 1 - cell.weights[1];
+        w *= corner & 4 ? cell.weights[2] : 1 - cell.weights[2];
+
+        const Node &node = tiles[corner][FluidFieldFormat::nodeOffset(x, y, z)];
+        sample->density += w * node.density;
+        sample->temperature += w * node.temperature;
+        sample->current += w * QVector3D(node.current[0], node.current[1], node.current[2]);
+    }
+}
+
+const Node *StreamingFluidField::pin(qint64 key) const
+{
+    QHash<qint64, Tile>::iterator it = m_tiles.find(key);
+
+    if (it == m_tiles.end()) {
+        evict();
+
+        uchar *nodes = m_file.map(m_nodesOffset + key * TileSize, TileSize);
+        if (!nodes) {
+            return 0;
+        }
+
+        Tile tile;
+        tile.nodes = reinterpret_cast<const Node *>(nodes);
+        tile.pins = 0;
+
+        it = m_tiles.insert(key, tile);
+    } else if (it->pins == 0) {
+        m_recent.erase(it->recent);
+    }
+
+    it->pins++;
+
+    return it->nodes;
+}
+
+bool StreamingFluidField::pinFrame(int frame, const FluidFieldFormat::Cell &cell, qint64 keys[8],
+                                   const Node *tiles[8]) const
+{
+    for (int corner = 0; corner < 8; corner++) {
+        keys[corner] = tileKey(frame, cell, corner);
+        tiles[corner] = pin(keys[corner]);
+
+        if (!tiles[corner]) {
+            for (int i = 0; i < corner; i++) {
+                unpin(keys[i]);
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int StreamingFluidField::nearestResidentFrame(int frame, const FluidFieldFormat::Cell &cell) const
+{
+    for (int distance = 1; distance < m_frameTimes.size(); distance++) {
+        for (int candidate : { frame - distance, frame + distance }) {
+            if (candidate < 0 || candidate >= m_frameTimes.size()) {
+                continue;
+            }
+
+            bool resident = true;
+            for (int corner = 0; corner < 8 && resident; corner++) {
+                resident = m_tiles.contains(tileKey(candidate, cell, corner));
+            }
+
+            if (resident) {
+                return candidate;
+            }
+        }
+    }
+
+    return -1;
+}
+
+void StreamingFluidField::unpin(qint64 key) const
+{
+    Tile &tile = m_tiles[key];
+
+    if (--tile.pins == 0) {
+        tile.recent = m_recent.insert(m_recent.end(), key);
+    }
+}
+
+void StreamingFluidField::touch(qint64 key) const
+{
+    Tile &tile = m_tiles[key];
+
+    if (tile.pins == 0) {
+        m_recent.erase(tile.recent);
+        tile.recent = m_recent.insert(m_recent.end(), key);
+    }
+}
+
+void StreamingFluidField::evict() const
+{
+    // pinned tiles aren't in m_recent, so while all are in use the
+    // capacity is overrun rather than waited for
+    while (m_tiles.size() >= m_capacity && !m_recent.isEmpty()) {
+        qint64 key = m_recent.takeFirst();
+
+        QHash<qint64, Tile>::iterator it = m_tiles.find(key);
+        m_file.unmap(reinterpret_cast<uchar *>(const_cast<Node *>(it->nodes)));
+        m_tiles.erase(it);
+    }
+}
+
+QVector<qint64> StreamingFluidField::predictTiles(const Hint &hint) const
+{
+    // points along the straight line path, half a brick apart, each
+    // needing the bricks around it in the frames around the time it is
+    // reached; the nearest come first
+    float brickLength = BrickSize * qMin(m_spacing.x(), qMin(m_spacing.y(), m_spacing.z()));
+    float distance = hint.velocity.length() * Lookahead;
+    int points = qBound(2, int(std::ceil(2 * distance / brickLength)) + 1, MaxPathPoints);
+
+    QVector<qint64> keys;
+    QSet<qint64> seen;
+
+    for (int i = 0; i < points; i++) {
+        double dt = Lookahead * i / (points - 1);
+
+        FluidFieldFormat::Cell cell = FluidFieldFormat::locateCell(hint.position + hint.velocity * dt,
+                                                                   m_origin, m_spacing, m_size);
+
+        float t;
+        int frame = FluidFieldFormat::locateFrame(m_frameTimes.constData(), m_frameTimes.size(),
+                                                  hint.time + dt, &t);
+        int lastFrame = qMin(frame + 1, m_frameTimes.size() - 1);
+
+        for (int f = frame; f <= lastFrame; f++) {
+            for (int corner = 0; corner < 8; corner++) {
+                qint64 key = tileKey(f, cell, corner);
+                if (!seen.contains(key)) {
+                    seen.insert(key);
+                    keys.append(key);
+                }
+            }
+        }
+    }
+
+    return keys;
+}
+
+void StreamingFluidField::prefetchTiles()
+{
+    QMutexLocker locker(&m_mutex);
+
+    forever {
+        while (m_hints.isEmpty() && !m_stopping) {
+            m_hintsChanged.wait(&m_mutex);
+        }
+
+        if (m_stopping) {
+            return;
+        }
+
+        QHash<const void *, Hint> hints;
+        hints.swap(m_hints);
+
+        locker.unlock();
+
+        for (const Hint &hint : hints) {
+            QVector<qint64> keys = predictTiles(hint);
+
+            // tiles already resident only need to be marked as used
+            QVector<qint64> missing;
+
+            locker.relock();
+            for (qint64 key : keys) {
+                if (m_tiles.contains(key)) {
+                    touch(key);
+                } else {
+                    missing.append(key);
+                }
+            }
+            locker.unlock();
+
+            // the rest are mapped one at a time, and their pages read in
+            // with the lock released, so that sampling isn't held up by the
+            // disk; pinning keeps them from being evicted meanwhile
+            for (qint64 key : missing) {
+                locker.relock();
+
+                if (m_stopping) {
+                    return;
+                }
+
+                if (m_tiles.contains(key)) {
+                    locker.unlock();
+                    continue;
+                }
+
+                // sample() reports tiles that can't be mapped if it needs them
+                const char *bytes = reinterpret_cast<const char *>(pin(key));
+                if (!bytes) {
+                    locker.unlock();
+                    continue;
+                }
+
+                locker.unlock();
+
+                volatile char touched = 0;
+                for (qint64 offset = 0; offset < TileSize; offset += PageSize) {
+                    touched = touched + bytes[offset];
+                }
+
+                locker.relock();
+                unpin(key);
+                locker.unlock();
+            }
+        }
+
+        locker.relock();
+    }
+}
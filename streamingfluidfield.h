@@ -0,0 +1,102 @@
+#ifndef STREAMINGFLUIDFIELD_H
+#define STREAMINGFLUIDFIELD_H
+
+#include <QFile>
+#include <QHash>
+#include <QLinkedList>
+#include <QMutex>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "fluidfield.h"
+#include "fluidfieldformat.h"
+
+class QThread;
+
+// A fluid field read from a FluidFieldFormat file too large to hold in
+// memory. Each brick of each frame is a tile, mapped from the file when it
+// is first needed and unmapped again when it is the least recently used of
+// more than residentTiles. A background thread maps the tiles along the
+// path predicted by prefetch() ahead of time, so that sample() rarely has
+// to wait for the disk. Where a tile can't be mapped, sample() makes do
+// with the nearest frame that is resident, or else a sample taken when the
+// file was opened.
+class StreamingFluidField : public FluidField
+{
+public:
+    ~StreamingFluidField();
+
+    static const int DefaultResidentTiles = 4096;
+
+    static StreamingFluidField *open(const QString &fileName, int residentTiles, QString *error);
+
+    FluidSample sample(const QVector3D &position, double time) const;
+    void prefetch(const void *source, const QVector3D &position, const QVector3D &velocity, double time) const;
+
+    int residentTiles() const;
+
+private:
+    class Prefetcher;
+
+    struct Tile
+    {
+        const FluidFieldFormat::Node *nodes;
+
+        // a pinned tile is being read outside the lock, and is kept out of
+        // m_recent until the last reader unpins it
+        int pins;
+        QLinkedList<qint64>::iterator recent;
+    };
+
+    struct Hint
+    {
+        QVector3D position;
+        QVector3D velocity;
+        double time;
+    };
+
+    StreamingFluidField();
+
+    qint64 tileKey(int frame, const FluidFieldFormat::Cell &cell, int corner) const;
+    void sampleFrame(const FluidFieldFormat::Node *const tiles[8], const FluidFieldFormat::Cell &cell,
+                     float frameWeight, FluidSample *sample) const;
+
+    // m_mutex must be held; pin() returns 0 if the tile can't be mapped, and
+    // pinFrame() pins all of a cell's corners in a frame or none of them
+    const FluidFieldFormat::Node *pin(qint64 key) const;
+    bool pinFrame(int frame, const FluidFieldFormat::Cell &cell, qint64 keys[8],
+                  const FluidFieldFormat::Node *tiles[8]) const;
+    int nearestResidentFrame(int frame, const FluidFieldFormat::Cell &cell) const;
+    void unpin(qint64 key) const;
+    void touch(qint64 key) const;
+    void evict() const;
+
+    QVector<qint64> predictTiles(const Hint &hint) const;
+    void prefetchTiles();
+
+    QVector3D m_origin;
+    QVector3D m_spacing;
+    int m_size[3];
+    int m_bricks[3];
+    int m_frameBricks;
+    QVector<double> m_frameTimes;
+    qint64 m_nodesOffset;
+
+    int m_capacity;
+
+    mutable QMutex m_mutex;
+    mutable QFile m_file;
+    mutable QHash<qint64, Tile> m_tiles;
+    mutable QLinkedList<qint64> m_recent;  // unpinned tiles, least recently used first
+
+    FluidSample m_fallback;
+    mutable bool m_mapFailed;
+
+    // the latest hint from each source
+    mutable QHash<const void *, Hint> m_hints;
+    mutable QWaitCondition m_hintsChanged;
+    bool m_stopping;
+    QThread *m_prefetcher;
+};
+
+#endif // STREAMINGFLUIDFIELD_H
@@ -2,35 +2,20 @@
 
 #include <bullet/btBulletDynamicsCommon.h>
 
-#include <Qt3DCore/QEntity>
-#include <Qt3DCore/QCamera>
-#include <Qt3DCore/QCameraLens>
-#include <Qt3DCore/QTransform>
-#include <Qt3DCore/QLookAtTransform>
-#include <Qt3DCore/QScaleTransform>
-#include <Qt3DCore/QRotateTransform>
-#include <Qt3DCore/QTranslateTransform>
-#include <Qt3DCore/QAspectEngine>
-
-#include <Qt3DRenderer/QPhongMaterial>
-#include <Qt3DRenderer/QSphereMesh>
-#include <Qt3DRenderer/QMesh>
-
-#include <Qt3DInput/QInputAspect>
-
+#include <QDataStream>
 #include <QVector2D>
-#include <QPropertyAnimation>
 
 #include <QtMath>
 #include <QtDebug>
 
 #include "fin.h"
 #include "fluid.h"
-#include "forcearrow.h"
 #include "physics/body.h"
 #include "physics/force.h"
+#include "physics/forcepipeline.h"
 #include "physics/torque.h"
-#include "torquearrow.h"
+#include "propertypath.h"
+#include "simulationsnapshot.h"
 
 #include "submarine.h"
 
@@ -39,16 +24,52 @@ btVector3 qtVector2btVector(QVector3D v)
     return btVector3(v.x(), v.y(), v.z());
 }
 
+namespace {
+
+// btScalar is widened to double, so that states round trip exactly
+// whichever precision Bullet was built with
+
+QDataStream &operator<<(QDataStream &out, const btVector3 &v)
+{
+    return out << double(v.x()) << double(v.y()) << double(v.z());
+}
+
+QDataStream &operator>>(QDataStream &in, btVector3 &v)
+{
+    double x, y, z;
+    in >> x >> y >> z;
+    v.setValue(x, y, z);
+
+    return in;
+}
+
+QDataStream &operator<<(QDataStream &out, const btTransform &t)
+{
+    const btMatrix3x3 &basis = t.getBasis();
+    return out << basis[0] << basis[1] << basis[2] << t.getOrigin();
+}
+
+QDataStream &operator>>(QDataStream &in, btTransform &t)
+{
+    btMatrix3x3 &basis = t.getBasis();
+    return in >> basis[0] >> basis[1] >> basis[2] >> t.getOrigin();
+}
+
+}
+
 Submarine::Submarine(QObject *parent) :
     QObject(parent),
     m_shape(0),
     m_body(0),
-    m_entity(0),
+    m_shapeChanged(false),
     m_length(0),
     m_width(0),
     m_height(0),
     m_mass(0),
     m_propellorTorque(new Physics::PropellorTorque(this)),
+    m_propellorRatedThrust(0),
+    m_propellorRatedRpm(0),
+    m_propellorAngle(0),
     m_hasHorizontalFins(false),
     m_horizontalFinsArea(0),
     m_horizontalFinsLiftCoefficientSlope(0),
@@ -66,13 +87,24 @@ Submarine::Submarine(QObject *parent) :
     m_thrust(new Physics::ThrustForce(this)),
     m_drag(new Physics::DragForce(this)),
     m_lift(new Physics::LiftForce(this)),
-    m_spinningDrag(new Physics::SpinningDragTorque(this))
+    m_spinningDrag(new Physics::SpinningDragTorque(this)),
+    m_pipeline(new Physics::ForcePipeline())
 {
+    m_propellorTorque->setObjectName("propellorTorque");
+    m_weight->setObjectName("weight");
+    m_buoyancy->setObjectName("buoyancy");
+    m_thrust->setObjectName("thrust");
+    m_drag->setObjectName("drag");
+    m_lift->setObjectName("lift");
+    m_spinningDrag->setObjectName("spinningDrag");
 
+    collectForces();
 }
 
 Submarine::~Submarine()
 {
+    delete m_pipeline;
+
     if (m_shape) {
         delete m_shape;
     }
@@ -93,6 +125,8 @@ Submarine *Submarine::makeDefault(QObject *parent)
     submarine->weight()->setPosition(QVector3D());
     submarine->thrust()->setValue(QVector3D(100, 0, 10));
     submarine->propellorTorque()->setValue(QVector3D(20, 0, 0));
+    submarine->setPropellorRatedThrust(100);
+    submarine->setPropellorRatedRpm(120);
 
     submarine->setHasHorizontalFins(true);
     submarine->setHorizontalFinsLiftCoefficientSlope(M_PI);
@@ -130,12 +164,15 @@ void Submarine::addToWorld(btDynamicsWorld *world)
 
     body->setSleepingThresholds(0, 0);
 
-    auto motionState = new btDefaultMotionState();
+    body->setCenterOfMassTransform(initialTransform());
+
+    auto motionState = new btDefaultMotionState(initialTransform());
     body->setMotionState(motionState);
 
     world->addRigidBody(body);
 
     m_body = new Physics::Body(body, this);
+    m_shapeChanged = false;
 
     m_propellorTorque->setBody(m_body);
     m_weight->setBody(m_body);
@@ -145,11 +182,12 @@ void Submarine::addToWorld(btDynamicsWorld *world)
     m_lift->setBody(m_body);
     m_spinningDrag->setBody(m_body);
 
-    for (Fin *fin : m_fins) {
-        fin->drag()->setBody(m_body);
-        fin->lift()->setBody(m_body);
-        fin->damping()->setBody(m_body);
+    if (!finsMatch()) {
+        makeFins();
     }
+
+    updateFins();
+    compileForces();
 }
 
 void Submarine::removeFromWorld(btDynamicsWorld *world)
@@ -167,257 +205,254 @@ void Submarine::removeFromWorld(btDynamicsWorld *world)
     m_shape = 0;
 }
 
-void Submarine::addToScene(Qt3D::QEntity *scene)
+void Submarine::resetInWorld(btDynamicsWorld *world)
 {
-    if (m_entity) {
-        qFatal("Already added to the scene.");
+    if (!m_body && !m_shape) {
+        qFatal("Not added to the world.");
     }
 
-    m_entity = new Qt3D::QEntity(scene);
+    // the shape and mass are baked into the rigid body, so only a change to
+    // those needs new allocations
+    if (m_shapeChanged) {
+        removeFromWorld(world);
+        addToWorld(world);
+        return;
+    }
 
-    auto material = new Qt3D::QPhongMaterial(scene);
-    material->setAmbient(QColor(50, 50, 50));
+    btRigidBody *body = m_body->body();
 
-    makeBodyEntity(material);
-    makePropellorEntity(material);
-    makeFinsEntities(scene, material);
+    btTransform transform = initialTransform();
+    btVector3 zero(0, 0, 0);
 
-    Qt3D::QTransform *transform = new Qt3D::QTransform(m_entity);
+    body->setCenterOfMassTransform(transform);
+    body->setInterpolationWorldTransform(transform);
+    body->getMotionState()->setWorldTransform(transform);
 
-    m_translateTransform = new Qt3D::QTranslateTransform(m_entity);
-    m_translateTransform->setTranslation(QVector3D(0, 0, 0));
+    body->setLinearVelocity(zero);
+    body->setAngularVelocity(zero);
+    body->setInterpolationLinearVelocity(zero);
+    body->setInterpolationAngularVelocity(zero);
+    body->clearForces();
 
-    m_rotateTransform = new Qt3D::QRotateTransform(m_entity);
-    m_rotateTransform->setAxis(QVector3D(0, 1, 0));
-    m_rotateTransform->setAngleDeg(0);
+    world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(body->getBroadphaseHandle(),
+                                                                           world->getDispatcher());
+    world->updateSingleAabb(body);
 
-    transform->addTransform(m_rotateTransform);
-    transform->addTransform(m_translateTransform);
+    m_body->updateKinematics();
+    m_propellorAngle = 0;
 
-    m_entity->addComponent(transform);
+    if (!finsMatch()) {
+        makeFins();
+    }
 
-    makeForceArrows(scene);
+    updateFins();
+    compileForces();
 }
 
-void Submarine::makeBodyEntity(Qt3D::QPhongMaterial *material)
+void Submarine::saveState(QDataStream &out) const
 {
-    auto bodyEntity = new Qt3D::QEntity(m_entity);
-
-    auto mesh = new Qt3D::QSphereMesh(bodyEntity);
-    mesh->setRadius(0.5);
-    mesh->setRings(24);
-    mesh->setSlices(48);
-    bodyEntity->addComponent(mesh);
+    const btRigidBody *body = m_body->body();
 
-    bodyEntity->addComponent(material);
+    out << body->getCenterOfMassTransform()
+        << body->getInterpolationWorldTransform()
+        << body->getLinearVelocity()
+        << body->getAngularVelocity()
+        << body->getInterpolationLinearVelocity()
+        << body->getInterpolationAngularVelocity()
+        << body->getTotalForce()
+        << body->getTotalTorque()
+        << qint32(body->getActivationState())
+        << double(body->getDeactivationTime())
+        << m_propellorAngle;
 
-    Qt3D::QTransform *bodyTransform = new Qt3D::QTransform(bodyEntity);
-
-    Qt3D::QScaleTransform *bodyScaleTransform = new Qt3D::QScaleTransform(bodyEntity);
-    bodyScaleTransform->setScale3D(QVector3D(m_length, m_height, m_width));
-    bodyTransform->addTransform(bodyScaleTransform);
-
-    bodyEntity->addComponent(bodyTransform);
+    m_pipeline->saveResults(out);
 }
 
-void Submarine::makePropellorEntity(Qt3D::QPhongMaterial *material)
+bool Submarine::restoreState(QDataStream &in, btDynamicsWorld *world)
 {
-    auto propellorEntity = new Qt3D::QEntity(m_entity);
+    btTransform transform;
+    btTransform interpolationTransform;
+    btVector3 linearVelocity;
+    btVector3 angularVelocity;
+    btVector3 interpolationLinearVelocity;
+    btVector3 interpolationAngularVelocity;
+    btVector3 totalForce;
+    btVector3 totalTorque;
+    qint32 activationState;
+    double deactivationTime;
+    double propellorAngle;
+
+    in >> transform
+       >> interpolationTransform
+       >> linearVelocity
+       >> angularVelocity
+       >> interpolationLinearVelocity
+       >> interpolationAngularVelocity
+       >> totalForce
+       >> totalTorque
+       >> activationState
+       >> deactivationTime
+       >> propellorAngle;
+
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
 
-    auto mesh = new Qt3D::QMesh(propellorEntity);
-    mesh->setSource(QUrl("qrc:/models/propellor.obj"));
-    propellorEntity->addComponent(mesh);
+    // brings the shape, fins and compiled forces in line with the restored
+    // parameters before the dynamic state goes on top
+    resetInWorld(world);
 
-    propellorEntity->addComponent(material);
+    btRigidBody *body = m_body->body();
 
-    auto transform = new Qt3D::QTransform(propellorEntity);
+    body->setCenterOfMassTransform(transform);
+    body->setInterpolationWorldTransform(interpolationTransform);
+    body->getMotionState()->setWorldTransform(transform);
 
-    auto scaleTransform = new Qt3D::QScaleTransform(propellorEntity);
-    scaleTransform->setScale(0.025);
-    transform->addTransform(scaleTransform);
+    body->setLinearVelocity(linearVelocity);
+    body->setAngularVelocity(angularVelocity);
+    body->setInterpolationLinearVelocity(interpolationLinearVelocity);
+    body->setInterpolationAngularVelocity(interpolationAngularVelocity);
 
-    auto rotateTransform = new Qt3D::QRotateTransform(propellorEntity);
-    rotateTransform->setAxis(QVector3D(0, 1, 0));
-    rotateTransform->setAngleDeg(-90);
-    transform->addTransform(rotateTransform);
+    body->clearForces();
+    body->applyCentralForce(totalForce);
+    body->applyTorque(totalTorque);
 
-    auto rotateTransform2 = new Qt3D::QRotateTransform(propellorEntity);
-    rotateTransform2->setAxis(QVector3D(1, 0, 0));
-    transform->addTransform(rotateTransform2);
+    body->forceActivationState(activationState);
+    body->setDeactivationTime(deactivationTime);
 
-    auto translateTransform = new Qt3D::QTranslateTransform(propellorEntity);
-    translateTransform->setDx(-m_length / 2);
-    transform->addTransform(translateTransform);
+    world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(body->getBroadphaseHandle(),
+                                                                           world->getDispatcher());
+    world->updateSingleAabb(body);
 
-    auto rotationAnimation = new QPropertyAnimation(propellorEntity);
-    rotationAnimation->setTargetObject(rotateTransform2);
-    rotationAnimation->setPropertyName("angle");
-    rotationAnimation->setStartValue(QVariant::fromValue(0));
-    rotationAnimation->setEndValue(QVariant::fromValue(360));
-    rotationAnimation->setDuration(500);
-    rotationAnimation->setLoopCount(-1);
-    rotationAnimation->start();
+    m_body->updateKinematics();
+    m_propellorAngle = propellorAngle;
 
-    propellorEntity->addComponent(transform);
+    return m_pipeline->restoreResults(in);
 }
 
-void Submarine::makeFinsEntities(Qt3D::QEntity *scene, Qt3D::QPhongMaterial *material)
+bool Submarine::finsMatch() const
 {
-    if (m_hasHorizontalFins) {
-        auto hEntity1 = new Fin(scene, m_entity);
-        hEntity1->setSubmarine(this);
-        hEntity1->setArea(m_horizontalFinsArea);
-        hEntity1->calculatePosition(Fin::North, m_horizontalFinsPosition);
-        hEntity1->addComponent(material);
-        hEntity1->drag()->setCoefficient(m_horizontalFinsDragCoefficient);
-        hEntity1->lift()->setCoefficientSlope(m_horizontalFinsLiftCoefficientSlope);
-        m_fins.append(hEntity1);
-
-        auto hEntity2 = new Fin(scene, m_entity);
-        hEntity2->setSubmarine(this);
-        hEntity2->setArea(m_horizontalFinsArea);
-        hEntity2->calculatePosition(Fin::South, m_horizontalFinsPosition);
-        hEntity2->addComponent(material);
-        hEntity2->drag()->setCoefficient(m_horizontalFinsDragCoefficient);
-        hEntity2->lift()->setCoefficientSlope(m_horizontalFinsLiftCoefficientSlope);
-        m_fins.append(hEntity2);
-    }
+    bool horizontal = false;
+    bool vertical = false;
 
-    if (m_hasVerticalFins) {
-        auto vEntity1 = new Fin(scene, m_entity);
-        vEntity1->setSubmarine(this);
-        vEntity1->setArea(m_verticalFinsArea);
-        vEntity1->calculatePosition(Fin::East, m_verticalFinsPosition);
-        vEntity1->addComponent(material);
-        vEntity1->drag()->setCoefficient(m_verticalFinsDragCoefficient);
-        vEntity1->lift()->setCoefficientSlope(m_verticalFinsLiftCoefficientSlope);
-        m_fins.append(vEntity1);
-
-        auto vEntity2 = new Fin(scene, m_entity);
-        vEntity2->setSubmarine(this);
-        vEntity2->setArea(m_verticalFinsArea);
-        vEntity2->calculatePosition(Fin::West, m_verticalFinsPosition);
-        vEntity2->addComponent(material);
-        vEntity2->drag()->setCoefficient(m_verticalFinsDragCoefficient);
-        vEntity2->lift()->setCoefficientSlope(m_verticalFinsLiftCoefficientSlope);
-        m_fins.append(vEntity2);
+    for (const Fin *fin : m_fins) {
+        if (fin->orientation() == Fin::North || fin->orientation() == Fin::South) {
+            horizontal = true;
+        } else {
+            vertical = true;
+        }
     }
-}
-
-void Submarine::makeForceArrows(Qt3D::QEntity *scene)
-{
-    auto weightArrow = new ForceArrow(QColor(0xe67e22), 0.3, scene);
-    weightArrow->setForce(m_weight);
-
-    auto buoyancyArrow = new ForceArrow(QColor(0x9b59b6), 0.3, scene);
-    buoyancyArrow->setForce(m_buoyancy);
 
-    auto thrustArrow = new ForceArrow(QColor(0x2c3e50), 5., scene);
-    thrustArrow->setForce(m_thrust);
-
-    auto dragArrow = new ForceArrow(QColor(0x2ecc71), 5., scene);
-    dragArrow->setForce(m_drag);
-
-    auto liftArrow = new ForceArrow(QColor(0xe74c3c), 3.5, scene);
-    liftArrow->setForce(m_lift);
-
-    auto propellorTorqueArrow = new TorqueArrow(Qt::red, 0.25, scene);
-    propellorTorqueArrow->setTorque(m_propellorTorque);
-
-    auto spinningDragArrow = new TorqueArrow(Qt::blue, 1., scene);
-    spinningDragArrow->setTorque(m_spinningDrag);
-}
-
-void Submarine::update(const Fluid *fluid, Qt3D::QCamera *camera)
-{
-    updateTransformation();
-    updateCamera(camera);
-    updateForces(fluid);
+    return horizontal == bool(m_hasHorizontalFins) && vertical == bool(m_hasVerticalFins);
 }
 
-void Submarine::updateTransformation()
+void Submarine::makeFins()
 {
-    btMotionState *motionState = m_body->body()->getMotionState();
+    // the fins' forces go with them
+    qDeleteAll(m_fins);
+    m_fins.clear();
 
-    btTransform transform;
-    motionState->getWorldTransform(transform);
+    if (m_hasHorizontalFins) {
+        m_fins.append(new Fin(Fin::North, this));
+        m_fins.append(new Fin(Fin::South, this));
+    }
 
-    btVector3 t = transform.getOrigin();
-    QVector3D position(t.x(), t.y(), t.z());
-    m_translateTransform->setTranslation(position);
+    if (m_hasVerticalFins) {
+        m_fins.append(new Fin(Fin::East, this));
+        m_fins.append(new Fin(Fin::West, this));
+    }
 
-    btQuaternion q = transform.getRotation();
-    btVector3 a = q.getAxis();
-    m_rotateTransform->setAxis(QVector3D(a.x(), a.y(), a.z()));
-    m_rotateTransform->setAngleRad(q.getAngle());
+    collectForces();
 }
 
-void Submarine::updateCamera(Qt3D::QCamera *camera)
+void Submarine::collectForces()
 {
-    QVector3D position = m_translateTransform->translation();
-    camera->lookAt()->setPosition(position + QVector3D(2, 4, 10));
-    camera->lookAt()->setViewCenter(position);
-}
+    m_forces.clear();
+    m_forces << m_weight << m_buoyancy << m_thrust << m_drag << m_lift;
 
-void Submarine::updateForces(const Fluid *fluid)
-{
-    applyPropellorTorque();
-    applyWeight();
-    applyBuoyancy();
-    applyThrust();
-    applyDrag(fluid);
-    applyLift(fluid);
-    applySpinningDrag(fluid);
+    m_torques.clear();
+    m_torques << m_propellorTorque << m_spinningDrag;
 
     for (Fin *fin : m_fins) {
-        fin->applyForces(fluid);
+        m_forces << fin->lift() << fin->drag();
+        m_torques << fin->damping();
     }
 }
 
-void Submarine::applyPropellorTorque()
+void Submarine::updateFins()
 {
-    m_propellorTorque->apply();
-}
-
-void Submarine::applyWeight()
-{
-    m_weight->apply();
+    for (Fin *fin : m_fins) {
+        fin->setSubmarine(this);
+
+        if (fin->orientation() == Fin::North || fin->orientation() == Fin::South) {
+            fin->setArea(m_horizontalFinsArea);
+            fin->setAspectRatio(m_horizontalFinsAspectRatio);
+            fin->calculatePosition(fin->orientation(), m_horizontalFinsPosition);
+            fin->drag()->setCoefficient(m_horizontalFinsDragCoefficient);
+            fin->lift()->setCoefficientSlope(m_horizontalFinsLiftCoefficientSlope);
+        } else {
+            fin->setArea(m_verticalFinsArea);
+            fin->setAspectRatio(m_verticalFinsAspectRatio);
+            fin->calculatePosition(fin->orientation(), m_verticalFinsPosition);
+            fin->drag()->setCoefficient(m_verticalFinsDragCoefficient);
+            fin->lift()->setCoefficientSlope(m_verticalFinsLiftCoefficientSlope);
+        }
+    }
 }
 
-void Submarine::applyBuoyancy()
+void Submarine::updateForces(const Fluid *fluid, double time)
 {
-    m_buoyancy->apply();
+    m_pipeline->evaluate(m_body, fluid, time);
+    m_pipeline->publish();
 }
 
-void Submarine::applyThrust()
+void Submarine::updatePropellor(double timeStep)
 {
-    m_thrust->apply();
+    m_propellorAngle = std::fmod(m_propellorAngle + propellorRpm() * 6 * timeStep, 360.);
 }
 
-void Submarine::applyDrag(const Fluid *fluid)
+void Submarine::compileForces()
 {
     m_drag->setCrossSectionalArea(crossSectionalArea());
-    m_drag->setFluidDensity(fluid->density());
 
-    m_drag->apply();
-}
-
-void Submarine::applyLift(const Fluid *fluid)
-{
     m_lift->setPitchCrossSectionalArea(M_PI * m_width * m_length);
     m_lift->setYawCrossSectionalArea(M_PI * m_height * m_length);
-    m_lift->setFluidDensity(fluid->density());
 
-    m_lift->apply();
+    m_spinningDrag->setPitchCrossSectionalArea(M_PI * m_width * m_length);
+    m_spinningDrag->setYawCrossSectionalArea(M_PI * m_height * m_length);
+
+    m_pipeline->compile(m_forces, m_torques);
+
+    updateLayout();
 }
 
-void Submarine::applySpinningDrag(const Fluid *fluid)
+void Submarine::updateLayout()
 {
-    m_spinningDrag->setFluidDensity(fluid->density());
-    m_spinningDrag->setPitchCrossSectionalArea(M_PI * m_width * m_length);
-    m_spinningDrag->setYawCrossSectionalArea(M_PI * m_height * m_length);
+    SubmarineLayout *layout = new SubmarineLayout();
+    layout->size = QVector3D(m_length, m_height, m_width);
+
+    for (const Fin *fin : m_fins) {
+        FinLayout finLayout;
+        finLayout.position = fin->drag()->position().x();
+        finLayout.radius = fin->damping()->radius();
+        finLayout.angle = fin->angle();
+        layout->fins.append(finLayout);
+    }
 
-    m_spinningDrag->apply();
+    for (const Physics::Force *force : m_forces) {
+        layout->forces.append(objectPath(this, force));
+    }
+
+    for (const Physics::Torque *torque : m_torques) {
+        layout->torques.append(objectPath(this, torque));
+    }
+
+    m_layout = QSharedPointer<const SubmarineLayout>(layout);
+}
+
+btTransform Submarine::initialTransform() const
+{
+    return btTransform(btQuaternion::getIdentity(), qtVector2btVector(m_initialPosition));
 }
 
 Physics::Body *Submarine::body() const
@@ -425,6 +460,11 @@ Physics::Body *Submarine::body() const
     return m_body;
 }
 
+QSharedPointer<const SubmarineLayout> Submarine::layout() const
+{
+    return m_layout;
+}
+
 double Submarine::crossSectionalArea() const
 {
     return M_PI * m_width * m_height;
@@ -437,6 +477,10 @@ double Submarine::length() const
 
 void Submarine::setLength(double length)
 {
+    if (m_length != length) {
+        m_shapeChanged = true;
+    }
+
     m_length = length;
 
     m_lift->setPosition(QVector3D(length / 4., 0, 0));
@@ -451,6 +495,10 @@ double Submarine::width() const
 
 void Submarine::setWidth(double width)
 {
+    if (m_width != width) {
+        m_shapeChanged = true;
+    }
+
     m_width = width;
 }
 
@@ -461,6 +509,10 @@ double Submarine::height() const
 
 void Submarine::setHeight(double height)
 {
+    if (m_height != height) {
+        m_shapeChanged = true;
+    }
+
     m_height = height;
 }
 
@@ -471,9 +523,23 @@ double Submarine::mass() const
 
 void Submarine::setMass(double mass)
 {
+    if (m_mass != mass) {
+        m_shapeChanged = true;
+    }
+
     m_mass = mass;
 }
 
+QVector3D Submarine::initialPosition() const
+{
+    return m_initialPosition;
+}
+
+void Submarine::setInitialPosition(const QVector3D &initialPosition)
+{
+    m_initialPosition = initialPosition;
+}
+
 double Submarine::hasHorizontalFins() const
 {
     return m_hasHorizontalFins;
@@ -599,6 +665,54 @@ Physics::PropellorTorque *Submarine::propellorTorque() const
     return m_propellorTorque;
 }
 
+double Submarine::propellorRatedThrust() const
+{
+    return m_propellorRatedThrust;
+}
+
+void Submarine::setPropellorRatedThrust(double propellorRatedThrust)
+{
+    m_propellorRatedThrust = propellorRatedThrust;
+}
+
+double Submarine::propellorRatedRpm() const
+{
+    return m_propellorRatedRpm;
+}
+
+void Submarine::setPropellorRatedRpm(double propellorRatedRpm)
+{
+    m_propellorRatedRpm = propellorRatedRpm;
+}
+
+double Submarine::propellorRpm() const
+{
+    if (m_propellorRatedThrust <= 0) {
+        return 0;
+    }
+
+    // thrust goes with the square of the shaft speed, and reverses with it
+    double thrust = m_thrust->value().x();
+    double rpm = m_propellorRatedRpm * std::sqrt(std::abs(thrust) / m_propellorRatedThrust);
+
+    return thrust < 0 ? -rpm : rpm;
+}
+
+double Submarine::propellorAngle() const
+{
+    return m_propellorAngle;
+}
+
+const QVector<Physics::Force *> &Submarine::forces() const
+{
+    return m_forces;
+}
+
+const QVector<Physics::Torque *> &Submarine::torques() const
+{
+    return m_torques;
+}
+
 Physics::WeightForce *Submarine::weight() const
 {
     return m_weight;
@@ -2,26 +2,25 @@
 #define SUBMARINE_H
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QVector3D>
 #include <QVector>
 
-namespace Qt3D {
-class QEntity;
-class QTranslateTransform;
-class QRotateTransform;
-class QCamera;
-class QPhongMaterial;
-}
+class QDataStream;
 
 class btCapsuleShape;
 class btRigidBody;
 class btDynamicsWorld;
+class btTransform;
 class btVector3;
 
 namespace Physics {
 class Body;
+class Force;
+class Torque;
 class BuoyancyForce;
 class DragForce;
+class ForcePipeline;
 class LiftForce;
 class PropellorTorque;
 class SpinningDragTorque;
@@ -31,7 +30,7 @@ class WeightForce;
 
 class Fin;
 class Fluid;
-class ForceArrow;
+struct SubmarineLayout;
 
 class Submarine : public QObject
 {
@@ -45,36 +44,32 @@ public:
 
     void addToWorld(btDynamicsWorld *world);
     void removeFromWorld(btDynamicsWorld *world);
+    void resetInWorld(btDynamicsWorld *world);
 
-    void addToScene(Qt3D::QEntity *scene);
+    void saveState(QDataStream &out) const;
+    bool restoreState(QDataStream &in, btDynamicsWorld *world);
 
 private:
-    void makeBodyEntity(Qt3D::QPhongMaterial *material);
-    void makePropellorEntity(Qt3D::QPhongMaterial *material);
-    void makeFinsEntities(Qt3D::QEntity *scene, Qt3D::QPhongMaterial *material);
-    void makeForceArrows(Qt3D::QEntity *scene);
+    bool finsMatch() const;
+    void makeFins();
+    void collectForces();
+    void updateFins();
 
 public:
-    void update(const Fluid *fluid, Qt3D::QCamera *camera);
+    void updateForces(const Fluid *fluid, double time);
+    void updatePropellor(double timeStep);
 
 private:
-    void updateTransformation();
-    void updateCamera(Qt3D::QCamera *camera);
-    void updateForces(const Fluid *fluid);
-
-    void applyPropellorTorque();
-    void applyWeight();
-    void applyBuoyancy();
-    void applyThrust();
-    void applyDrag(const Fluid *fluid);
-    void applyLift(const Fluid *fluid);
-    void applyPitchSpinningDrag(const Fluid *fluid);
-    void applyYawSpinningDrag(const Fluid *fluid);
-    void applySpinningDrag(const Fluid *fluid);
+    void compileForces();
+    void updateLayout();
+    btTransform initialTransform() const;
 
 public:
     Physics::Body *body() const;
 
+    // rebuilt whenever the submarine is added to or reset in the world
+    QSharedPointer<const SubmarineLayout> layout() const;
+
     double crossSectionalArea() const;
 
     double length() const;
@@ -89,6 +84,9 @@ public:
     double mass() const;
     void setMass(double mass);
 
+    QVector3D initialPosition() const;
+    void setInitialPosition(const QVector3D &initialPosition);
+
     double hasHorizontalFins() const;
     void setHasHorizontalFins(double hasHorizontalFins);
 
@@ -127,10 +125,22 @@ public:
 
     Physics::PropellorTorque *propellorTorque() const;
 
+    // the shaft turns at propellorRatedRpm when the thrust is
+    // propellorRatedThrust, and with the square root of the thrust otherwise
+    double propellorRatedThrust() const;
+    void setPropellorRatedThrust(double propellorRatedThrust);
+
+    double propellorRatedRpm() const;
+    void setPropellorRatedRpm(double propellorRatedRpm);
+
+    double propellorRpm() const;
+    double propellorAngle() const;
+
     Q_PROPERTY(double length READ length WRITE setLength)
     Q_PROPERTY(double width READ width WRITE setWidth)
     Q_PROPERTY(double height READ height WRITE setHeight)
     Q_PROPERTY(double mass READ mass WRITE setMass)
+    Q_PROPERTY(QVector3D initialPosition READ initialPosition WRITE setInitialPosition)
     Q_PROPERTY(double crossSectionalArea READ crossSectionalArea STORED false)
     Q_PROPERTY(bool hasHorizontalFins READ hasHorizontalFins WRITE setHasHorizontalFins)
     Q_PROPERTY(double horizontalFinsArea READ horizontalFinsArea WRITE setHorizontalFinsArea)
@@ -144,6 +154,12 @@ public:
     Q_PROPERTY(double verticalFinsDragCoefficient READ verticalFinsDragCoefficient WRITE setVerticalFinsDragCoefficient)
     Q_PROPERTY(double verticalFinsPosition READ verticalFinsPosition WRITE setVerticalFinsPosition)
     Q_PROPERTY(double verticalFinsAspectRatio READ verticalFinsAspectRatio WRITE setVerticalFinsAspectRatio)
+    Q_PROPERTY(double propellorRatedThrust READ propellorRatedThrust WRITE setPropellorRatedThrust)
+    Q_PROPERTY(double propellorRatedRpm READ propellorRatedRpm WRITE setPropellorRatedRpm)
+    Q_PROPERTY(double propellorRpm READ propellorRpm STORED false)
+
+    const QVector<Physics::Force *> &forces() const;
+    const QVector<Physics::Torque *> &torques() const;
 
     Physics::WeightForce *weight() const;
     Physics::BuoyancyForce *buoyancy() const;
@@ -155,19 +171,25 @@ public:
 private:
     btCapsuleShape *m_shape;
     Physics::Body *m_body;
-
-    Qt3D::QEntity *m_entity;
-    Qt3D::QTranslateTransform *m_translateTransform;
-    Qt3D::QRotateTransform *m_rotateTransform;
+    bool m_shapeChanged;
 
     QVector<Fin *> m_fins;
+    QVector<Physics::Force *> m_forces;
+    QVector<Physics::Torque *> m_torques;
+
+    QSharedPointer<const SubmarineLayout> m_layout;
 
     double m_length;
     double m_width;
     double m_height;
     double m_mass;
+    QVector3D m_initialPosition;
     Physics::PropellorTorque *m_propellorTorque;
 
+    double m_propellorRatedThrust;
+    double m_propellorRatedRpm;
+    double m_propellorAngle;  // degrees
+
     double m_hasHorizontalFins;
     double m_horizontalFinsArea;
     double m_horizontalFinsLiftCoefficientSlope;
@@ -188,6 +210,8 @@ private:
     Physics::DragForce *m_drag;
     Physics::LiftForce *m_lift;
     Physics::SpinningDragTorque *m_spinningDrag;
+
+    Physics::ForcePipeline *m_pipeline;
 };
 
 #endif // SUBMARINE_H
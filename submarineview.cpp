@@ -0,0 +1,274 @@
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QCamera>
+#include <Qt3DCore/QTransform>
+#include <Qt3DCore/QLookAtTransform>
+#include <Qt3DCore/QScaleTransform>
+#include <Qt3DCore/QRotateTransform>
+#include <Qt3DCore/QTranslateTransform>
+
+#include <Qt3DRenderer/QPhongMaterial>
+#include <Qt3DRenderer/QSphereMesh>
+#include <Qt3DRenderer/QGeometryRenderer>
+
+#include "assetcache.h"
+#include "forcearrow.h"
+#include "simulationsnapshot.h"
+#include "torquearrow.h"
+
+#include "submarineview.h"
+
+namespace {
+
+struct ArrowStyle
+{
+    const char *name;
+    QRgb colour;
+    float scale;
+};
+
+// the hull's forces and torques by path, and the fins' by their last segment
+const ArrowStyle HullForceStyles[] = {
+    { "weight", 0xe67e22, 0.3f },
+    { "buoyancy", 0x9b59b6, 0.3f },
+    { "thrust", 0x2c3e50, 5.f },
+    { "drag", 0x2ecc71, 5.f },
+    { "lift", 0xe74c3c, 3.5f }
+};
+
+const ArrowStyle HullTorqueStyles[] = {
+    { "propellorTorque", 0xff0000, 0.25f },
+    { "spinningDrag", 0x0000ff, 1.f }
+};
+
+const ArrowStyle FinForceStyles[] = {
+    { "lift", 0xc0392b, 200.f },
+    { "drag", 0x27ae60, 150.f }
+};
+
+const ArrowStyle FinTorqueStyles[] = {
+    { "damping", 0xf1c40f, 1000.f }
+};
+
+template <int N>
+const ArrowStyle *findStyle(const ArrowStyle (&styles)[N], const QString &name)
+{
+    for (const ArrowStyle &style : styles) {
+        if (name == QLatin1String(style.name)) {
+            return &style;
+        }
+    }
+
+    return 0;
+}
+
+const ArrowStyle *forceStyle(const QString &path)
+{
+    int dot = path.lastIndexOf('.');
+    if (dot < 0) {
+        return findStyle(HullForceStyles, path);
+    }
+
+    return findStyle(FinForceStyles, path.mid(dot + 1));
+}
+
+const ArrowStyle *torqueStyle(const QString &path)
+{
+    int dot = path.lastIndexOf('.');
+    if (dot < 0) {
+        return findStyle(HullTorqueStyles, path);
+    }
+
+    return findStyle(FinTorqueStyles, path.mid(dot + 1));
+}
+
+}
+
+SubmarineView::SubmarineView(Qt3D::QEntity *scene, AssetCache *assets, ArrowRenderer *arrows, QObject *parent) :
+    QObject(parent),
+    m_scene(scene),
+    m_assets(assets),
+    m_arrows(arrows),
+    m_entity(0),
+    m_translateTransform(0),
+    m_rotateTransform(0),
+    m_propellorTransform(0)
+{
+
+}
+
+void SubmarineView::setLayout(const QSharedPointer<const SubmarineLayout> &layout)
+{
+    if (layout == m_layout) {
+        return;
+    }
+
+    clear();
+
+    m_layout = layout;
+    if (!m_layout) {
+        return;
+    }
+
+    m_entity = new Qt3D::QEntity(m_scene);
+
+    Qt3D::QPhongMaterial *material = m_assets->material(QColor(50, 50, 50));
+
+    makeBodyEntity(material);
+    makePropellorEntity(material);
+    makeFinsEntities(material);
+
+    Qt3D::QTransform *transform = new Qt3D::QTransform(m_entity);
+
+    m_translateTransform = new Qt3D::QTranslateTransform(m_entity);
+    m_translateTransform->setTranslation(QVector3D(0, 0, 0));
+
+    m_rotateTransform = new Qt3D::QRotateTransform(m_entity);
+    m_rotateTransform->setAxis(QVector3D(0, 1, 0));
+    m_rotateTransform->setAngleDeg(0);
+
+    transform->addTransform(m_rotateTransform);
+    transform->addTransform(m_translateTransform);
+
+    m_entity->addComponent(transform);
+
+    makeArrows();
+}
+
+void SubmarineView::clear()
+{
+    qDeleteAll(m_forceArrows);
+    qDeleteAll(m_torqueArrows);
+    m_forceArrows.clear();
+    m_torqueArrows.clear();
+
+    delete m_entity;
+    m_entity = 0;
+    m_translateTransform = 0;
+    m_rotateTransform = 0;
+    m_propellorTransform = 0;
+}
+
+void SubmarineView::makeBodyEntity(Qt3D::QPhongMaterial *material)
+{
+    auto bodyEntity = new Qt3D::QEntity(m_entity);
+
+    bodyEntity->addComponent(m_assets->sphere());
+
+    bodyEntity->addComponent(material);
+
+    Qt3D::QTransform *bodyTransform = new Qt3D::QTransform(bodyEntity);
+
+    Qt3D::QScaleTransform *bodyScaleTransform = new Qt3D::QScaleTransform(bodyEntity);
+    bodyScaleTransform->setScale3D(m_layout->size);
+    bodyTransform->addTransform(bodyScaleTransform);
+
+    bodyEntity->addComponent(bodyTransform);
+}
+
+void SubmarineView::makePropellorEntity(Qt3D::QPhongMaterial *material)
+{
+    auto propellorEntity = new Qt3D::QEntity(m_entity);
+
+    propellorEntity->addComponent(m_assets->mesh(":/models/propellor.obj"));
+
+    propellorEntity->addComponent(material);
+
+    auto transform = new Qt3D::QTransform(propellorEntity);
+
+    auto scaleTransform = new Qt3D::QScaleTransform(propellorEntity);
+    scaleTransform->setScale(0.025);
+    transform->addTransform(scaleTransform);
+
+    auto rotateTransform = new Qt3D::QRotateTransform(propellorEntity);
+    rotateTransform->setAxis(QVector3D(0, 1, 0));
+    rotateTransform->setAngleDeg(-90);
+    transform->addTransform(rotateTransform);
+
+    m_propellorTransform = new Qt3D::QRotateTransform(propellorEntity);
+    m_propellorTransform->setAxis(QVector3D(1, 0, 0));
+    transform->addTransform(m_propellorTransform);
+
+    auto translateTransform = new Qt3D::QTranslateTransform(propellorEntity);
+    translateTransform->setDx(-m_layout->size.x() / 2);
+    transform->addTransform(translateTransform);
+
+    propellorEntity->addComponent(transform);
+}
+
+void SubmarineView::makeFinsEntities(Qt3D::QPhongMaterial *material)
+{
+    for (const FinLayout &fin : m_layout->fins) {
+        auto finEntity = new Qt3D::QEntity(m_entity);
+
+        finEntity->addComponent(m_assets->mesh(":/models/fin.obj"));
+
+        finEntity->addComponent(material);
+
+        auto rotateTransform = new Qt3D::QRotateTransform(finEntity);
+        rotateTransform->setAxis(QVector3D(1, 0, 0));
+        rotateTransform->setAngleDeg(fin.angle);
+
+        auto translateTransform = new Qt3D::QTranslateTransform(finEntity);
+        translateTransform->setDx(fin.position);
+        translateTransform->setDy(fin.radius);
+
+        auto transform = new Qt3D::QTransform(finEntity);
+        transform->addTransform(translateTransform);
+        transform->addTransform(rotateTransform);
+        finEntity->addComponent(transform);
+    }
+}
+
+void SubmarineView::makeArrows()
+{
+    for (const QString &path : m_layout->forces) {
+        const ArrowStyle *style = forceStyle(path);
+        m_forceArrows.append(style ? new ForceArrow(m_arrows, QColor(style->colour), style->scale, this) : 0);
+    }
+
+    for (const QString &path : m_layout->torques) {
+        const ArrowStyle *style = torqueStyle(path);
+        m_torqueArrows.append(style ? new TorqueArrow(m_arrows, QColor(style->colour), style->scale, this) : 0);
+    }
+}
+
+void SubmarineView::updateScene(const QVector3D &position, const QQuaternion &rotation, double propellorAngle,
+                                Qt3D::QCamera *camera)
+{
+    if (!m_entity) {
+        return;
+    }
+
+    m_translateTransform->setTranslation(position);
+
+    float angle;
+    QVector3D axis;
+    rotation.getAxisAndAngle(&axis, &angle);
+
+    m_rotateTransform->setAxis(axis);
+    m_rotateTransform->setAngleDeg(angle);
+
+    m_propellorTransform->setAngleDeg(propellorAngle);
+
+    camera->lookAt()->setPosition(position + QVector3D(2, 4, 10));
+    camera->lookAt()->setViewCenter(position);
+}
+
+void SubmarineView::updateArrows(const SimulationSnapshot &snapshot)
+{
+    int forceCount = qMin(m_forceArrows.size(), snapshot.forces.size());
+    for (int i = 0; i < forceCount; i++) {
+        if (m_forceArrows[i]) {
+            const ForceSample &sample = snapshot.forces[i];
+            m_forceArrows[i]->update(sample.value, sample.position);
+        }
+    }
+
+    int torqueCount = qMin(m_torqueArrows.size(), snapshot.torques.size());
+    for (int i = 0; i < torqueCount; i++) {
+        if (m_torqueArrows[i]) {
+            const ForceSample &sample = snapshot.torques[i];
+            m_torqueArrows[i]->update(sample.value, sample.position);
+        }
+    }
+}
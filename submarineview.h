@@ -0,0 +1,66 @@
+#ifndef SUBMARINEVIEW_H
+#define SUBMARINEVIEW_H
+
+#include <QObject>
+#include <QQuaternion>
+#include <QSharedPointer>
+#include <QVector3D>
+#include <QVector>
+
+namespace Qt3D {
+class QCamera;
+class QEntity;
+class QPhongMaterial;
+class QRotateTransform;
+class QTranslateTransform;
+}
+
+class ArrowRenderer;
+class AssetCache;
+class ForceArrow;
+class TorqueArrow;
+struct SimulationSnapshot;
+struct SubmarineLayout;
+
+// The followed submarine in the 3D view: its hull, propellor, fins and
+// force arrows, built from the layout carried by the snapshots and rebuilt
+// whenever that changes, so that drawing never touches the simulation.
+class SubmarineView : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SubmarineView(Qt3D::QEntity *scene, AssetCache *assets, ArrowRenderer *arrows, QObject *parent = 0);
+
+    void setLayout(const QSharedPointer<const SubmarineLayout> &layout);
+
+    void updateScene(const QVector3D &position, const QQuaternion &rotation, double propellorAngle,
+                     Qt3D::QCamera *camera);
+    void updateArrows(const SimulationSnapshot &snapshot);
+
+private:
+    void clear();
+
+    void makeBodyEntity(Qt3D::QPhongMaterial *material);
+    void makePropellorEntity(Qt3D::QPhongMaterial *material);
+    void makeFinsEntities(Qt3D::QPhongMaterial *material);
+    void makeArrows();
+
+    Qt3D::QEntity *m_scene;
+    AssetCache *m_assets;
+    ArrowRenderer *m_arrows;
+
+    QSharedPointer<const SubmarineLayout> m_layout;
+
+    Qt3D::QEntity *m_entity;
+    Qt3D::QTranslateTransform *m_translateTransform;
+    Qt3D::QRotateTransform *m_rotateTransform;
+    Qt3D::QRotateTransform *m_propellorTransform;
+
+    // indexed like the layout's forces and torques, null where a force has
+    // no arrow
+    QVector<ForceArrow *> m_forceArrows;
+    QVector<TorqueArrow *> m_torqueArrows;
+};
+
+#endif // SUBMARINEVIEW_H
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstring>
+
+#include "telemetryformat.h"
+
+#include "telemetryfile.h"
+
+TelemetryFile::TelemetryFile() :
+    m_map(0),
+    m_rowCount(0),
+    m_capacity(0),
+    m_data(0)
+{
+
+}
+
+TelemetryFile::~TelemetryFile()
+{
+    close();
+}
+
+bool TelemetryFile::open(const QString &fileName)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    if (m_file.size() < qint64(sizeof(Telemetry::Header))) {
+        m_errorString = "Not a telemetry file";
+        close();
+        return false;
+    }
+
+    m_map = m_file.map(0, m_file.size());
+    if (!m_map) {
+        m_errorString = m_file.errorString();
+        close();
+        return false;
+    }
+
+    const Telemetry::Header *header = reinterpret_cast<const Telemetry::Header *>(m_map);
+
+    if (memcmp(header->magic, Telemetry::Magic, sizeof(header->magic)) != 0) {
+        m_errorString = "Not a telemetry file";
+        close();
+        return false;
+    }
+
+    if (header->version != Telemetry::Version) {
+        m_errorString = QString("Unsupported telemetry version %1").arg(header->version);
+        close();
+        return false;
+    }
+
+    // a file that is still being recorded may grow, but this mapping won't,
+    // so only the rows that were complete when it was opened are read
+    qint64 namesEnd = sizeof(Telemetry::Header) + qint64(header->columnCount) * header->columnNameSize;
+    qint64 dataEnd = header->headerSize + qint64(header->columnCount) * header->capacity * sizeof(double);
+
+    if (header->headerSize < namesEnd || header->headerSize % sizeof(double) != 0 ||
+            dataEnd > m_file.size() || header->rowCount > header->capacity) {
+        m_errorString = "Truncated or corrupt telemetry file";
+        close();
+        return false;
+    }
+
+    const char *name = reinterpret_cast<const char *>(m_map + sizeof(Telemetry::Header));
+    for (quint32 i = 0; i < header->columnCount; i++) {
+        m_columnNames << QString::fromLatin1(name, qstrnlen(name, header->columnNameSize));
+        name += header->columnNameSize;
+    }
+
+    m_rowCount = header->rowCount;
+    m_capacity = header->capacity;
+    m_data = reinterpret_cast<const double *>(m_map + header->headerSize);
+
+    return true;
+}
+
+void TelemetryFile::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = 0;
+    }
+
+    m_file.close();
+
+    m_columnNames.clear();
+    m_rowCount = 0;
+    m_capacity = 0;
+    m_data = 0;
+}
+
+bool TelemetryFile::isOpen() const
+{
+    return m_data != 0;
+}
+
+int TelemetryFile::columnCount() const
+{
+    return m_columnNames.size();
+}
+
+qint64 TelemetryFile::rowCount() const
+{
+    return m_rowCount;
+}
+
+QStringList TelemetryFile::columnNames() const
+{
+    return m_columnNames;
+}
+
+int TelemetryFile::indexOf(const QString &name) const
+{
+    return m_columnNames.indexOf(name);
+}
+
+const double *TelemetryFile::column(int index) const
+{
+    return m_data + index * m_capacity;
+}
+
+double TelemetryFile::value(qint64 row, int column) const
+{
+    return m_data[column * m_capacity + row];
+}
+
+qint64 TelemetryFile::rowAt(double time) const
+{
+    // the time column is the index: rows are recorded in time order, so the
+    // last row at or before a time is found by a binary search
+    const double *times = column(0);
+    qint64 row = std::upper_bound(times, times + m_rowCount, time) - times - 1;
+
+    return qBound(qint64(0), row, m_rowCount - 1);
+}
+
+double TelemetryFile::startTime() const
+{
+    return m_rowCount > 0 ? value(0, 0) : 0;
+}
+
+double TelemetryFile::endTime() const
+{
+    return m_rowCount > 0 ? value(m_rowCount - 1, 0) : 0;
+}
+
+QString TelemetryFile::fileName() const
+{
+    return m_file.fileName();
+}
+
+QString TelemetryFile::errorString() const
+{
+    return m_errorString;
+}
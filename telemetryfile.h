@@ -0,0 +1,45 @@
+#ifndef TELEMETRYFILE_H
+#define TELEMETRYFILE_H
+
+#include <QFile>
+#include <QStringList>
+
+// read only access to a file written by TelemetryRecorder
+class TelemetryFile
+{
+public:
+    TelemetryFile();
+    ~TelemetryFile();
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const;
+
+    int columnCount() const;
+    qint64 rowCount() const;
+
+    QStringList columnNames() const;
+    int indexOf(const QString &name) const;
+
+    const double *column(int index) const;
+    double value(qint64 row, int column) const;
+
+    qint64 rowAt(double time) const;
+    double startTime() const;
+    double endTime() const;
+
+    QString fileName() const;
+    QString errorString() const;
+
+private:
+    QFile m_file;
+    uchar *m_map;
+    QString m_errorString;
+
+    QStringList m_columnNames;
+    qint64 m_rowCount;
+    qint64 m_capacity;
+    const double *m_data;
+};
+
+#endif // TELEMETRYFILE_H
@@ -0,0 +1,40 @@
+#ifndef TELEMETRYFORMAT_H
+#define TELEMETRYFORMAT_H
+
+#include <QtGlobal>
+
+// A telemetry file is laid out as
+//
+//   Telemetry::Header
+//   char name[columnNameSize] for every column, NUL padded
+//   double data[columnCount][capacity]
+//
+// Every value is little endian and the data starts at headerSize, which is
+// a multiple of 8, so the whole file can be mapped and each column read as
+// a plain array of doubles. Only the first rowCount entries of a column are
+// valid. rowCount is updated after every row, so a file whose writer died
+// can still be read; a cleanly closed file has capacity == rowCount.
+
+namespace Telemetry {
+
+const char Magic[8] = { 'S', 'U', 'B', 'T', 'E', 'L', 'E', 'M' };
+const quint32 Version = 1;
+const quint32 ColumnNameSize = 48;
+
+struct Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 headerSize;
+    quint32 columnCount;
+    quint32 columnNameSize;
+    quint64 rowCount;
+    quint64 capacity;
+};
+
+Q_STATIC_ASSERT(sizeof(Header) == 40);
+Q_STATIC_ASSERT(Q_BYTE_ORDER == Q_LITTLE_ENDIAN);
+
+}
+
+#endif // TELEMETRYFORMAT_H
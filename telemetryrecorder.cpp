@@ -0,0 +1,264 @@
+#include <QVector3D>
+
+#include <cstring>
+
+#include "physics/body.h"
+#include "physics/force.h"
+#include "physics/torque.h"
+#include "propertypath.h"
+#include "simulationcore.h"
+#include "submarine.h"
+#include "telemetryformat.h"
+
+#include "telemetryrecorder.h"
+
+namespace {
+
+const qint64 InitialCapacity = 4096;
+
+}
+
+TelemetryRecorder::TelemetryRecorder() :
+    m_map(0),
+    m_columnCount(0),
+    m_forceCount(0),
+    m_torqueCount(0),
+    m_headerSize(0),
+    m_rowCount(0),
+    m_capacity(0)
+{
+
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    close();
+}
+
+bool TelemetryRecorder::open(const QString &fileName, const SimulationCore *core)
+{
+    close();
+    m_errorString.clear();
+
+    QStringList names = columnNames(core);
+    for (const QString &name : names) {
+        if (name.toLatin1().size() >= int(Telemetry::ColumnNameSize)) {
+            m_errorString = QString("Column name too long: %1").arg(name);
+            return false;
+        }
+    }
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    m_columnCount = names.size();
+    m_forceCount = core->submarine()->forces().size();
+    m_torqueCount = core->submarine()->torques().size();
+
+    m_headerSize = sizeof(Telemetry::Header) + m_columnCount * Telemetry::ColumnNameSize;
+    m_rowCount = 0;
+    m_capacity = 0;
+
+    if (!reserve(InitialCapacity)) {
+        m_file.close();
+        return false;
+    }
+
+    Telemetry::Header *h = header();
+    memcpy(h->magic, Telemetry::Magic, sizeof(h->magic));
+    h->version = Telemetry::Version;
+    h->headerSize = m_headerSize;
+    h->columnCount = m_columnCount;
+    h->columnNameSize = Telemetry::ColumnNameSize;
+    h->rowCount = 0;
+    h->capacity = m_capacity;
+
+    char *name = reinterpret_cast<char *>(m_map + sizeof(Telemetry::Header));
+    for (const QString &column : names) {
+        QByteArray latin1 = column.toLatin1();
+        memset(name, 0, Telemetry::ColumnNameSize);
+        memcpy(name, latin1.constData(), latin1.size());
+        name += Telemetry::ColumnNameSize;
+    }
+
+    return true;
+}
+
+void TelemetryRecorder::close()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    if (m_map) {
+        // pack the columns together so the file holds no unused capacity
+        double *columns = data();
+        for (int c = 1; c < m_columnCount; c++) {
+            memmove(columns + c * m_rowCount, columns + c * m_capacity, m_rowCount * sizeof(double));
+        }
+
+        header()->capacity = m_rowCount;
+
+        m_file.unmap(m_map);
+        m_map = 0;
+
+        m_file.resize(m_headerSize + m_columnCount * m_rowCount * sizeof(double));
+    }
+
+    m_file.close();
+}
+
+bool TelemetryRecorder::isOpen() const
+{
+    return m_map != 0;
+}
+
+void TelemetryRecorder::record(const SimulationCore *core)
+{
+    if (!m_map) {
+        return;
+    }
+
+    if (m_rowCount == m_capacity && !reserve(m_capacity * 2)) {
+        qCritical("Stopped recording telemetry to %s: %s",
+                  qPrintable(m_file.fileName()), qPrintable(m_errorString));
+        close();
+        return;
+    }
+
+    const Physics::KinematicState &state = core->submarine()->body()->kinematics();
+    const QVector<Physics::Force *> &forces = core->submarine()->forces();
+    const QVector<Physics::Torque *> &torques = core->submarine()->torques();
+
+    double *value = data() + m_rowCount;
+    const qint64 stride = m_capacity;
+
+    auto put = [&value, stride](double v) {
+        *value = v;
+        value += stride;
+    };
+
+    auto putVector = [&put](const QVector3D &v) {
+        put(v.x());
+        put(v.y());
+        put(v.z());
+    };
+
+    put(core->time());
+
+    putVector(state.position);
+
+    put(state.rotation.scalar());
+    putVector(state.rotation.vector());
+
+    putVector(state.linearVelocity);
+    putVector(state.angularVelocity);
+
+    put(state.roll);
+    put(state.yaw);
+    put(state.pitch);
+
+    put(state.rollAngleOfAttack);
+    put(state.yawAngleOfAttack);
+    put(state.pitchAngleOfAttack);
+
+    // the columns were fixed when the file was opened
+    for (int i = 0; i < m_forceCount; i++) {
+        putVector(i < forces.size() ? forces[i]->force() : QVector3D());
+        putVector(i < forces.size() ? forces[i]->worldPosition() : QVector3D());
+    }
+
+    for (int i = 0; i < m_torqueCount; i++) {
+        putVector(i < torques.size() ? torques[i]->value() : QVector3D());
+    }
+
+    m_rowCount++;
+    header()->rowCount = m_rowCount;
+}
+
+QString TelemetryRecorder::fileName() const
+{
+    return m_file.fileName();
+}
+
+QString TelemetryRecorder::errorString() const
+{
+    return m_errorString;
+}
+
+qint64 TelemetryRecorder::rowCount() const
+{
+    return m_rowCount;
+}
+
+QStringList TelemetryRecorder::columnNames(const SimulationCore *core)
+{
+    QStringList names;
+
+    names << "time"
+          << "x" << "y" << "z"
+          << "qw" << "qx" << "qy" << "qz"
+          << "vx" << "vy" << "vz"
+          << "wx" << "wy" << "wz"
+          << "roll" << "yaw" << "pitch"
+          << "rollAngleOfAttack" << "yawAngleOfAttack" << "pitchAngleOfAttack";
+
+    const Submarine *submarine = core->submarine();
+
+    for (const Physics::Force *force : submarine->forces()) {
+        QString path = objectPath(submarine, force);
+        names << path + ".force.x" << path + ".force.y" << path + ".force.z"
+              << path + ".worldPosition.x" << path + ".worldPosition.y" << path + ".worldPosition.z";
+    }
+
+    for (const Physics::Torque *torque : submarine->torques()) {
+        QString path = objectPath(submarine, torque);
+        names << path + ".value.x" << path + ".value.y" << path + ".value.z";
+    }
+
+    return names;
+}
+
+bool TelemetryRecorder::reserve(qint64 capacity)
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = 0;
+    }
+
+    if (!m_file.resize(m_headerSize + m_columnCount * capacity * sizeof(double))) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    m_map = m_file.map(0, m_file.size());
+    if (!m_map) {
+        m_errorString = m_file.errorString();
+        return false;
+    }
+
+    // spread the columns out to their new stride, last first so that no
+    // column is overwritten before it has been moved
+    double *columns = data();
+    for (int c = m_columnCount - 1; c > 0; c--) {
+        memmove(columns + c * capacity, columns + c * m_capacity, m_rowCount * sizeof(double));
+    }
+
+    m_capacity = capacity;
+    header()->capacity = capacity;
+
+    return true;
+}
+
+Telemetry::Header *TelemetryRecorder::header() const
+{
+    return reinterpret_cast<Telemetry::Header *>(m_map);
+}
+
+double *TelemetryRecorder::data() const
+{
+    return reinterpret_cast<double *>(m_map + m_headerSize);
+}
@@ -0,0 +1,50 @@
+#ifndef TELEMETRYRECORDER_H
+#define TELEMETRYRECORDER_H
+
+#include <QFile>
+#include <QStringList>
+
+class SimulationCore;
+
+namespace Telemetry {
+struct Header;
+}
+
+class TelemetryRecorder
+{
+public:
+    TelemetryRecorder();
+    ~TelemetryRecorder();
+
+    bool open(const QString &fileName, const SimulationCore *core);
+    void close();
+    bool isOpen() const;
+
+    void record(const SimulationCore *core);
+
+    QString fileName() const;
+    QString errorString() const;
+    qint64 rowCount() const;
+
+    static QStringList columnNames(const SimulationCore *core);
+
+private:
+    bool reserve(qint64 capacity);
+
+    Telemetry::Header *header() const;
+    double *data() const;
+
+    QFile m_file;
+    uchar *m_map;
+    QString m_errorString;
+
+    int m_columnCount;
+    int m_forceCount;
+    int m_torqueCount;
+
+    qint64 m_headerSize;
+    qint64 m_rowCount;
+    qint64 m_capacity;
+};
+
+#endif // TELEMETRYRECORDER_H
@@ -0,0 +1,32 @@
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTextStream>
+
+#include "meshdata.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QTextStream err(stderr);
+
+    QStringList arguments = a.arguments();
+    if (arguments.size() != 3) {
+        err << "Usage: meshconvert input.obj output.mesh" << endl;
+        return 2;
+    }
+
+    MeshData mesh;
+    QString error;
+
+    if (!readObj(arguments[1], &mesh, &error)) {
+        err << "Could not read " << arguments[1] << ": " << error << endl;
+        return 1;
+    }
+
+    if (!writeMesh(arguments[2], mesh, &error)) {
+        err << "Could not write " << arguments[2] << ": " << error << endl;
+        return 1;
+    }
+
+    return 0;
+}
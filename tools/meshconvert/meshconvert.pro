@@ -0,0 +1,22 @@
+#-------------------------------------------------
+#
+# Compiles OBJ models to the binary mesh format, run as part of the build
+#
+#-------------------------------------------------
+
+# meshdata.cpp works in QVector3D, from QtGui
+QT = core gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = meshconvert
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+SOURCES += main.cpp \
+    ../../meshdata.cpp
+
+HEADERS += ../../meshdata.h \
+    ../../meshformat.h
@@ -0,0 +1,64 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <QAtomicInt>
+
+// Single producer, single consumer, lock-free. The producer fills back()
+// and publishes it; the consumer picks up the latest published value with
+// update() and reads it from front(). Neither side ever waits, and values
+// published faster than they are consumed are simply skipped.
+
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() :
+        m_middle(1),
+        m_back(0),
+        m_front(2)
+    {
+
+    }
+
+    T &back()
+    {
+        return m_buffers[m_back];
+    }
+
+    void publish()
+    {
+        int middle = m_middle.fetchAndStoreOrdered(m_back | Dirty);
+        m_back = middle & IndexMask;
+    }
+
+    bool update()
+    {
+        if (!(m_middle.loadAcquire() & Dirty)) {
+            return false;
+        }
+
+        int middle = m_middle.fetchAndStoreOrdered(m_front);
+        m_front = middle & IndexMask;
+
+        return true;
+    }
+
+    const T &front() const
+    {
+        return m_buffers[m_front];
+    }
+
+private:
+    enum {
+        IndexMask = 3,
+        Dirty = 4
+    };
+
+    T m_buffers[3];
+
+    QAtomicInt m_middle;
+    int m_back;
+    int m_front;
+};
+
+#endif // TRIPLEBUFFER_H